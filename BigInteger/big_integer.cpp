@@ -1,55 +1,1412 @@
 #include "big_integer.h"
+#include "limb_kernels.h"
+#include "static_big_integer.h"
 #include <algorithm>
-#include <cmath>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <system_error>
+
+namespace {
+using Digit = BigInteger::DigitType;
+using DoubleDigit = BigInteger::DoubleDigitType;
+
+const size_t kDecimalChunkSize = 9;
+const BigInteger::DigitType kDecimalChunkMod = 1000000000;
+const double kLog10Of2 = 0.30102999566398119521;
+const size_t kKaratsubaThreshold = 32;
+const size_t kToom3Threshold = 256;
+const size_t kNttThreshold = 4096;
+const size_t kNttMaxLength = size_t{1} << 23;
+const size_t kReciprocalThreshold = 32;
+const size_t kRadixConversionThreshold = 32;
+const size_t kBarrettDivisionThreshold = 256;
+
+size_t CountBits(BigInteger::DigitType digit) {
+  size_t bits = 0;
+  while (digit != 0) {
+    digit >>= 1;
+    ++bits;
+  }
+  return bits;
+}
+
+// Extra threads currently running forked tasks, kept below BigInteger::max_threads.
+std::atomic<size_t> forked_threads{0};
+
+bool ReserveThread() {
+  size_t running = forked_threads.load();
+  while (running + 1 < BigInteger::max_threads) {
+    if (forked_threads.compare_exchange_weak(running, running + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Runs task on a new thread when its operands reach BigInteger::parallel_grain_limbs and the thread
+// budget allows, and right away otherwise, also when no thread can be started. Whatever the task
+// writes may only be read after Join.
+template <class Task>
+std::future<void> Fork(size_t limbs, Task task) {
+  if (limbs >= BigInteger::parallel_grain_limbs && ReserveThread()) {
+    // The reserved slot is given back by the new thread, or here if std::async fails to start it.
+    try {
+      return std::async(std::launch::async, [task]() mutable {
+        struct Release {
+          ~Release() {
+            forked_threads.fetch_sub(1);
+          }
+        } release;
+        task();
+      });
+    } catch (const std::system_error&) {
+      forked_threads.fetch_sub(1);
+    } catch (...) {
+      forked_threads.fetch_sub(1);
+      throw;
+    }
+  }
+  task();
+  return {};
+}
+
+void Join(std::future<void>& task) {
+  if (task.valid()) {
+    task.get();
+  }
+}
+
+void MulAddDigit(std::vector<BigInteger::DigitType>& digits, BigInteger::DigitType mul, BigInteger::DigitType add) {
+  BigInteger::DoubleDigitType carry = add;
+  for (auto& digit : digits) {
+    BigInteger::DoubleDigitType cur = static_cast<BigInteger::DoubleDigitType>(digit) * mul + carry;
+    digit = static_cast<BigInteger::DigitType>(cur);
+    carry = cur >> BigInteger::digit_bits;
+  }
+  if (carry != 0) {
+    digits.push_back(static_cast<BigInteger::DigitType>(carry));
+  }
+}
+
+BigInteger::DigitType DivDigit(std::vector<BigInteger::DigitType>& digits, BigInteger::DigitType divisor) {
+  BigInteger::DoubleDigitType rem = 0;
+  for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+    BigInteger::DoubleDigitType cur = (rem << BigInteger::digit_bits) | *it;
+    *it = static_cast<BigInteger::DigitType>(cur / divisor);
+    rem = cur % divisor;
+  }
+  while (!digits.empty() && digits.back() == 0) {
+    digits.pop_back();
+  }
+  return static_cast<BigInteger::DigitType>(rem);
+}
+
+void WriteChunk(char* out, BigInteger::DigitType chunk) {
+  for (size_t i = kDecimalChunkSize; i > 0; --i) {
+    out[i - 1] = static_cast<char>('0' + chunk % 10);
+    chunk /= 10;
+  }
+}
+
+void TrimDigits(std::vector<Digit>& digits) {
+  while (!digits.empty() && digits.back() == 0) {
+    digits.pop_back();
+  }
+}
+
+// Stores |value| as up to two limbs and returns how many are significant.
+size_t SplitInt64(int64_t value, Digit* digits) {
+  DoubleDigit magnitude = value < 0 ? 0 - static_cast<DoubleDigit>(value) : static_cast<DoubleDigit>(value);
+  digits[0] = static_cast<Digit>(magnitude);
+  digits[1] = static_cast<Digit>(magnitude >> BigInteger::digit_bits);
+  return digits[1] != 0 ? 2 : (digits[0] != 0 ? 1 : 0);
+}
+
+template <class Digits>
+void IncrementDigits(Digits& digits) {
+  for (auto& digit : digits) {
+    if (++digit != 0) {
+      return;
+    }
+  }
+  digits.push_back(1);
+}
+
+// Expects a non-zero value; the result may have a leading zero limb.
+template <class Digits>
+void DecrementDigits(Digits& digits) {
+  for (auto& digit : digits) {
+    if (digit-- != 0) {
+      return;
+    }
+  }
+}
+
+void MulDigits(const Digit* a, size_t n, const Digit* b, size_t m, Digit* out);
+
+// out[0, n + m) = a * b, quadratic kernel for small operands.
+void SchoolbookMul(const Digit* a, size_t n, const Digit* b, size_t m, Digit* out) {
+  std::fill(out, out + n + m, 0);
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit carry = 0;
+    for (size_t j = 0; j < m; ++j) {
+      DoubleDigit cur = out[i + j] + static_cast<DoubleDigit>(a[i]) * b[j] + carry;
+      out[i + j] = static_cast<Digit>(cur);
+      carry = cur >> BigInteger::digit_bits;
+    }
+    out[i + m] = static_cast<Digit>(carry);
+  }
+}
+
+// Splits both operands at h limbs; expects n >= m >= h, where m == h leaves the high half of b empty.
+void KaratsubaMul(const Digit* a, size_t n, const Digit* b, size_t m, Digit* out) {
+  size_t h = (n + 1) / 2;
+  std::future<void> low = Fork(m, [=] {
+    MulDigits(a, h, b, h, out);
+  });
+  std::future<void> high = Fork(m, [=] {
+    if (n - h >= m - h) {
+      MulDigits(a + h, n - h, b + h, m - h, out + 2 * h);
+    } else {
+      MulDigits(b + h, m - h, a + h, n - h, out + 2 * h);
+    }
+  });
+
+  std::vector<Digit> a_sum(h + 1);
+  std::vector<Digit> b_sum(h + 1);
+  a_sum[h] = AddDigits(a_sum.data(), a, h, a + h, n - h);
+  b_sum[h] = AddDigits(b_sum.data(), b, h, b + h, m - h);
+  std::vector<Digit> middle(2 * h + 2);
+  MulDigits(a_sum.data(), h + 1, b_sum.data(), h + 1, middle.data());
+  Join(low);
+  Join(high);
+  SubDigits(middle.data(), middle.data(), middle.size(), out, 2 * h);
+  SubDigits(middle.data(), middle.data(), middle.size(), out + 2 * h, n + m - 2 * h);
+
+  size_t middle_size = middle.size();
+  while (middle_size > 0 && middle[middle_size - 1] == 0) {
+    --middle_size;
+  }
+  AddDigits(out + h, out + h, n + m - h, middle.data(), middle_size);
+}
+
+struct SignedDigits {
+  std::vector<Digit> digits;
+  bool is_negative = false;
+};
+
+SignedDigits MakeSigned(const Digit* digits, size_t size) {
+  SignedDigits result;
+  result.digits.assign(digits, digits + size);
+  TrimDigits(result.digits);
+  return result;
+}
+
+SignedDigits AddSigned(const SignedDigits& l, const SignedDigits& r, bool negate_r = false) {
+  bool r_is_negative = r.is_negative != negate_r && !r.digits.empty();
+  SignedDigits result;
+  if (l.is_negative == r_is_negative) {
+    const auto& bigger = l.digits.size() >= r.digits.size() ? l.digits : r.digits;
+    const auto& smaller = l.digits.size() >= r.digits.size() ? r.digits : l.digits;
+    result.digits.resize(bigger.size() + 1);
+    result.digits.back() = AddDigits(result.digits.data(), bigger.data(), bigger.size(), smaller.data(), smaller.size());
+    result.is_negative = l.is_negative;
+  } else {
+    int cmp = CompareDigits(l.digits.data(), l.digits.size(), r.digits.data(), r.digits.size());
+    const auto& bigger = cmp >= 0 ? l.digits : r.digits;
+    const auto& smaller = cmp >= 0 ? r.digits : l.digits;
+    result.digits.resize(bigger.size());
+    SubDigits(result.digits.data(), bigger.data(), bigger.size(), smaller.data(), smaller.size());
+    result.is_negative = cmp >= 0 ? l.is_negative : r_is_negative;
+  }
+  TrimDigits(result.digits);
+  result.is_negative = result.is_negative && !result.digits.empty();
+  return result;
+}
+
+SignedDigits MulSigned(const SignedDigits& l, const SignedDigits& r) {
+  SignedDigits result;
+  if (l.digits.empty() || r.digits.empty()) {
+    return result;
+  }
+  result.digits.resize(l.digits.size() + r.digits.size());
+  if (l.digits.size() >= r.digits.size()) {
+    MulDigits(l.digits.data(), l.digits.size(), r.digits.data(), r.digits.size(), result.digits.data());
+  } else {
+    MulDigits(r.digits.data(), r.digits.size(), l.digits.data(), l.digits.size(), result.digits.data());
+  }
+  TrimDigits(result.digits);
+  result.is_negative = l.is_negative != r.is_negative;
+  return result;
+}
+
+// Exact division of a signed value by a small divisor.
+void DivSignedExact(SignedDigits& value, Digit divisor) {
+  DivDigit(value.digits, divisor);
+  value.is_negative = value.is_negative && !value.digits.empty();
+}
+
+// Toom-Cook 3-way: evaluates at 0, 1, -1, -2 and infinity and interpolates with Bodrato's sequence.
+void Toom3Mul(const Digit* a, size_t n, const Digit* b, size_t m, Digit* out) {
+  size_t k = (n + 2) / 3;
+  SignedDigits a0 = MakeSigned(a, k);
+  SignedDigits a1 = MakeSigned(a + k, k);
+  SignedDigits a2 = MakeSigned(a + 2 * k, n - 2 * k);
+  SignedDigits b0 = MakeSigned(b, k);
+  SignedDigits b1 = MakeSigned(b + k, k);
+  SignedDigits b2 = MakeSigned(b + 2 * k, m - 2 * k);
+
+  SignedDigits a02 = AddSigned(a0, a2);
+  SignedDigits a_at_1 = AddSigned(a02, a1);
+  SignedDigits a_at_minus_1 = AddSigned(a02, a1, true);
+  SignedDigits a_at_minus_2 = AddSigned(a_at_minus_1, a2);
+  a_at_minus_2 = AddSigned(AddSigned(a_at_minus_2, a_at_minus_2), a0, true);
+  SignedDigits b02 = AddSigned(b0, b2);
+  SignedDigits b_at_1 = AddSigned(b02, b1);
+  SignedDigits b_at_minus_1 = AddSigned(b02, b1, true);
+  SignedDigits b_at_minus_2 = AddSigned(b_at_minus_1, b2);
+  b_at_minus_2 = AddSigned(AddSigned(b_at_minus_2, b_at_minus_2), b0, true);
+
+  SignedDigits r0;
+  SignedDigits r1;
+  SignedDigits r_minus_1;
+  SignedDigits r_minus_2;
+  SignedDigits r_inf;
+  std::future<void> products[] = {
+      Fork(m, [&] { r0 = MulSigned(a0, b0); }),
+      Fork(m, [&] { r1 = MulSigned(a_at_1, b_at_1); }),
+      Fork(m, [&] { r_minus_1 = MulSigned(a_at_minus_1, b_at_minus_1); }),
+      Fork(m, [&] { r_minus_2 = MulSigned(a_at_minus_2, b_at_minus_2); }),
+  };
+  r_inf = MulSigned(a2, b2);
+  for (auto& product : products) {
+    Join(product);
+  }
+
+  SignedDigits r3 = AddSigned(r_minus_2, r1, true);
+  DivSignedExact(r3, 3);
+  r1 = AddSigned(r1, r_minus_1, true);
+  DivSignedExact(r1, 2);
+  SignedDigits r2 = AddSigned(r_minus_1, r0, true);
+  r3 = AddSigned(r2, r3, true);
+  DivSignedExact(r3, 2);
+  r3 = AddSigned(r3, AddSigned(r_inf, r_inf));
+  r2 = AddSigned(AddSigned(r2, r1), r_inf, true);
+  r1 = AddSigned(r1, r3, true);
+
+  std::fill(out, out + n + m, 0);
+  const SignedDigits* coefficients[] = {&r0, &r1, &r2, &r3, &r_inf};
+  for (size_t i = 0; i < 5; ++i) {
+    const auto& digits = coefficients[i]->digits;
+    AddDigits(out + i * k, out + i * k, n + m - i * k, digits.data(), digits.size());
+  }
+}
+
+struct NttPrime {
+  Digit modulus;
+  Digit root;
+};
+
+// Three NTT-friendly primes below 2^30 with primitive root 3. Their product exceeds n * (2^32)^2 for
+// every transform length up to kNttMaxLength, so CRT recombination of the residues is exact.
+const NttPrime kNttPrimes[] = {{998244353, 3}, {167772161, 3}, {469762049, 3}};
+
+Digit PowMod(DoubleDigit base, DoubleDigit exponent, Digit modulus) {
+  DoubleDigit result = 1;
+  base %= modulus;
+  while (exponent > 0) {
+    if (exponent & 1) {
+      result = result * base % modulus;
+    }
+    base = base * base % modulus;
+    exponent >>= 1;
+  }
+  return static_cast<Digit>(result);
+}
+
+// Montgomery arithmetic modulo a 30-bit prime with R = 2^32, used for the transform butterflies.
+class NttField {
+ public:
+  explicit NttField(Digit modulus) : modulus_(modulus) {
+    Digit inverse = modulus;
+    for (size_t i = 0; i < 4; ++i) {
+      inverse *= 2 - modulus * inverse;
+    }
+    neg_inverse_ = 0 - inverse;
+    r_squared_ = static_cast<Digit>((static_cast<DoubleDigit>(1) << 62) % modulus * 4 % modulus);
+  }
+
+  Digit Modulus() const {
+    return modulus_;
+  }
+
+  Digit Reduce(DoubleDigit value) const {
+    Digit m = static_cast<Digit>(value) * neg_inverse_;
+    Digit result = static_cast<Digit>((value + static_cast<DoubleDigit>(m) * modulus_) >> BigInteger::digit_bits);
+    return result >= modulus_ ? result - modulus_ : result;
+  }
+
+  Digit ToMontgomery(Digit value) const {
+    return Reduce(static_cast<DoubleDigit>(value) * r_squared_);
+  }
+
+  // Returns a * b mod p when exactly one of the operands is in Montgomery form.
+  Digit Mul(Digit a, Digit b) const {
+    return Reduce(static_cast<DoubleDigit>(a) * b);
+  }
+
+ private:
+  Digit modulus_;
+  Digit neg_inverse_;
+  Digit r_squared_;
+};
+
+// Powers root^k for k < size / 2 in Montgomery form, root being a primitive size-th root of unity.
+std::vector<Digit> NttTwiddles(const NttField& field, Digit root, size_t size) {
+  std::vector<Digit> twiddles(std::max<size_t>(size / 2, 1));
+  Digit step = field.ToMontgomery(root);
+  twiddles[0] = field.ToMontgomery(1);
+  for (size_t k = 1; k < twiddles.size(); ++k) {
+    twiddles[k] = field.Mul(twiddles[k - 1], step);
+  }
+  return twiddles;
+}
+
+void Ntt(std::vector<Digit>& values, const NttField& field, const std::vector<Digit>& twiddles) {
+  size_t size = values.size();
+  for (size_t i = 1, j = 0; i < size; ++i) {
+    size_t bit = size >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(values[i], values[j]);
+    }
+  }
+
+  Digit modulus = field.Modulus();
+  for (size_t length = 2; length <= size; length <<= 1) {
+    size_t half = length / 2;
+    size_t stride = size / length;
+    for (size_t i = 0; i < size; i += length) {
+      for (size_t k = 0; k < half; ++k) {
+        Digit u = values[i + k];
+        Digit v = field.Mul(values[i + k + half], twiddles[k * stride]);
+        values[i + k] = u + v >= modulus ? u + v - modulus : u + v;
+        values[i + k + half] = u >= v ? u - v : u + modulus - v;
+      }
+    }
+  }
+}
+
+std::vector<Digit> ConvolveModPrime(const Digit* a, size_t n, const Digit* b, size_t m, size_t size,
+                                    const NttPrime& prime) {
+  NttField field(prime.modulus);
+  Digit root = PowMod(prime.root, (prime.modulus - 1) / size, prime.modulus);
+  std::vector<Digit> twiddles = NttTwiddles(field, root, size);
+
+  std::vector<Digit> fa(size);
+  for (size_t i = 0; i < n; ++i) {
+    fa[i] = a[i] % prime.modulus;
+  }
+  Ntt(fa, field, twiddles);
+  if (a == b && n == m) {
+    for (auto& value : fa) {
+      value = field.Mul(field.ToMontgomery(value), value);
+    }
+  } else {
+    std::vector<Digit> fb(size);
+    for (size_t i = 0; i < m; ++i) {
+      fb[i] = b[i] % prime.modulus;
+    }
+    Ntt(fb, field, twiddles);
+    for (size_t i = 0; i < size; ++i) {
+      fa[i] = field.Mul(field.ToMontgomery(fa[i]), fb[i]);
+    }
+  }
+
+  Digit inverse_root = PowMod(root, prime.modulus - 2, prime.modulus);
+  Ntt(fa, field, NttTwiddles(field, inverse_root, size));
+  Digit size_inverse = field.ToMontgomery(PowMod(size, prime.modulus - 2, prime.modulus));
+  for (auto& value : fa) {
+    value = field.Mul(value, size_inverse);
+  }
+  return fa;
+}
+
+// Three-prime NTT product. Each coefficient is rebuilt with Garner's CRT as a value below 2^96 and
+// folded into out through a two-word running carry, so there is no rounding anywhere.
+void NttMul(const Digit* a, size_t n, const Digit* b, size_t m, Digit* out) {
+  size_t size = 1;
+  while (size < n + m - 1) {
+    size <<= 1;
+  }
+
+  std::vector<Digit> residues[3];
+  std::future<void> convolutions[2];
+  for (size_t i = 0; i < 2; ++i) {
+    convolutions[i] = Fork(m, [&, i] {
+      residues[i] = ConvolveModPrime(a, n, b, m, size, kNttPrimes[i]);
+    });
+  }
+  residues[2] = ConvolveModPrime(a, n, b, m, size, kNttPrimes[2]);
+  for (auto& convolution : convolutions) {
+    Join(convolution);
+  }
+
+  const DoubleDigit p1 = kNttPrimes[0].modulus;
+  const DoubleDigit p2 = kNttPrimes[1].modulus;
+  const DoubleDigit p3 = kNttPrimes[2].modulus;
+  const DoubleDigit p1_inverse_mod_p2 = PowMod(p1, p2 - 2, kNttPrimes[1].modulus);
+  const DoubleDigit p1p2_inverse_mod_p3 = PowMod(p1 * p2 % p3, p3 - 2, kNttPrimes[2].modulus);
+  const DoubleDigit p1p2_low = (p1 * p2) & static_cast<Digit>(-1);
+  const DoubleDigit p1p2_high = (p1 * p2) >> BigInteger::digit_bits;
+
+  DoubleDigit carry_low = 0;
+  DoubleDigit carry_high = 0;
+  for (size_t k = 0; k < n + m; ++k) {
+    DoubleDigit x_low = 0;
+    DoubleDigit x_high = 0;
+    if (k < n + m - 1) {
+      DoubleDigit t1 = residues[0][k];
+      DoubleDigit t2 = (residues[1][k] + p2 - t1 % p2) % p2 * p1_inverse_mod_p2 % p2;
+      DoubleDigit t3 = (residues[2][k] + 2 * p3 - t1 % p3 - t2 * p1 % p3) % p3 * p1p2_inverse_mod_p3 % p3;
+      DoubleDigit low = t1 + t2 * p1;
+      DoubleDigit product_low = t3 * p1p2_low;
+      DoubleDigit product_middle = t3 * p1p2_high;
+      x_low = product_low + (product_middle << BigInteger::digit_bits);
+      x_high = (product_middle >> BigInteger::digit_bits) + (x_low < product_low);
+      x_low += low;
+      x_high += x_low < low;
+    }
+
+    DoubleDigit sum_low = x_low + carry_low;
+    DoubleDigit sum_high = x_high + carry_high + (sum_low < x_low);
+    out[k] = static_cast<Digit>(sum_low);
+    carry_low = (sum_low >> BigInteger::digit_bits) | (sum_high << BigInteger::digit_bits);
+    carry_high = sum_high >> BigInteger::digit_bits;
+  }
+}
+
+// out[0, n + m) = a * b for n >= m, picking the kernel by operand size.
+void MulDigits(const Digit* a, size_t n, const Digit* b, size_t m, Digit* out) {
+  if (m < kKaratsubaThreshold) {
+    SchoolbookMul(a, n, b, m, out);
+    return;
+  }
+
+  if (n >= 2 * m) {
+    std::fill(out, out + n + m, 0);
+    std::vector<Digit> partial(2 * m);
+    for (size_t offset = 0; offset < n; offset += m) {
+      size_t chunk = std::min(m, n - offset);
+      if (chunk == m) {
+        MulDigits(a + offset, chunk, b, m, partial.data());
+      } else {
+        MulDigits(b, m, a + offset, chunk, partial.data());
+      }
+      AddDigits(out + offset, out + offset, n + m - offset, partial.data(), chunk + m);
+    }
+    return;
+  }
+
+  if (m >= kNttThreshold && n + m <= kNttMaxLength) {
+    NttMul(a, n, b, m, out);
+  } else if (m >= kToom3Threshold && m > 2 * ((n + 2) / 3)) {
+    Toom3Mul(a, n, b, m, out);
+  } else {
+    KaratsubaMul(a, n, b, m, out);
+  }
+}
+
+// out[0, n) = a[0, n) << shift for 0 <= shift < digit_bits; returns the bits shifted out of the top limb.
+Digit ShiftLeftDigits(Digit* out, const Digit* a, size_t n, size_t shift) {
+  if (shift == 0) {
+    std::copy(a, a + n, out);
+    return 0;
+  }
+  Digit carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    Digit digit = a[i];
+    out[i] = (digit << shift) | carry;
+    carry = digit >> (BigInteger::digit_bits - shift);
+  }
+  return carry;
+}
+
+// out[0, n) = a[0, n) >> shift for 0 <= shift < digit_bits.
+void ShiftRightDigits(Digit* out, const Digit* a, size_t n, size_t shift) {
+  if (shift == 0) {
+    std::copy(a, a + n, out);
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    Digit high = i + 1 < n ? a[i + 1] << (BigInteger::digit_bits - shift) : 0;
+    out[i] = (a[i] >> shift) | high;
+  }
+}
+
+// quotient[0, n) = a / divisor; returns the remainder.
+Digit DivModDigit(const Digit* a, size_t n, Digit divisor, Digit* quotient) {
+  DoubleDigit rem = 0;
+  for (size_t i = n; i > 0; --i) {
+    DoubleDigit cur = (rem << BigInteger::digit_bits) | a[i - 1];
+    quotient[i - 1] = static_cast<Digit>(cur / divisor);
+    rem = cur % divisor;
+  }
+  return static_cast<Digit>(rem);
+}
+
+// Knuth's Algorithm D for n >= m >= 2: quotient[0, n - m + 1) = a / b and remainder[0, m) = a % b.
+// The divisor is normalized so its top bit is set, which keeps every quotient estimate within two of
+// the true limb; the partial remainder is updated in place with a single multiply-subtract pass.
+void KnuthDivMod(const Digit* a, size_t n, const Digit* b, size_t m, Digit* quotient, Digit* remainder) {
+  size_t shift = BigInteger::digit_bits - CountBits(b[m - 1]);
+  std::vector<Digit> divisor(m);
+  ShiftLeftDigits(divisor.data(), b, m, shift);
+  std::vector<Digit> current(n + 1);
+  current[n] = ShiftLeftDigits(current.data(), a, n, shift);
+
+  const DoubleDigit base = static_cast<DoubleDigit>(1) << BigInteger::digit_bits;
+  const DoubleDigit top = divisor[m - 1];
+  const DoubleDigit second = divisor[m - 2];
+  for (size_t j = n - m + 1; j > 0; --j) {
+    Digit* window = current.data() + j - 1;
+    DoubleDigit numerator = (static_cast<DoubleDigit>(window[m]) << BigInteger::digit_bits) | window[m - 1];
+    DoubleDigit q_hat = numerator / top;
+    DoubleDigit r_hat = numerator % top;
+    while (q_hat >= base || q_hat * second > ((r_hat << BigInteger::digit_bits) | window[m - 2])) {
+      --q_hat;
+      r_hat += top;
+      if (r_hat >= base) {
+        break;
+      }
+    }
+
+    DoubleDigit carry = 0;
+    Digit borrow = 0;
+    for (size_t i = 0; i < m; ++i) {
+      DoubleDigit product = q_hat * divisor[i] + carry;
+      carry = product >> BigInteger::digit_bits;
+      DoubleDigit subtrahend = static_cast<DoubleDigit>(static_cast<Digit>(product)) + borrow;
+      borrow = window[i] < subtrahend;
+      window[i] = static_cast<Digit>(window[i] - subtrahend);
+    }
+    DoubleDigit subtrahend = carry + borrow;
+    borrow = window[m] < subtrahend;
+    window[m] = static_cast<Digit>(window[m] - subtrahend);
+
+    if (borrow != 0) {
+      --q_hat;
+      window[m] += AddDigits(window, window, m, divisor.data(), m);
+    }
+    quotient[j - 1] = static_cast<Digit>(q_hat);
+  }
+
+  ShiftRightDigits(remainder, current.data(), m, shift);
+}
+
+std::vector<Digit> MulMagnitudes(const std::vector<Digit>& l, const std::vector<Digit>& r) {
+  std::vector<Digit> result;
+  if (l.empty() || r.empty()) {
+    return result;
+  }
+  result.resize(l.size() + r.size());
+  if (l.size() >= r.size()) {
+    MulDigits(l.data(), l.size(), r.data(), r.size(), result.data());
+  } else {
+    MulDigits(r.data(), r.size(), l.data(), l.size(), result.data());
+  }
+  TrimDigits(result);
+  return result;
+}
+
+// quotient = a / b and remainder = a % b for a non-zero b; the outputs must not alias the inputs.
+void BarrettDivMod(const std::vector<Digit>& a, const std::vector<Digit>& d, std::vector<Digit>& quotient,
+                   std::vector<Digit>& remainder);
+
+// Computing the reciprocal costs several multiplications of the divisor's size, so Barrett division
+// only beats Knuth's algorithm for long quotients or very large divisors.
+bool UseBarrettDivision(size_t n, size_t m) {
+  return m >= kBarrettDivisionThreshold && (n >= 4 * m || m >= 8 * kBarrettDivisionThreshold);
+}
+
+void DivModMagnitudes(const std::vector<Digit>& a, const std::vector<Digit>& b, std::vector<Digit>& quotient,
+                      std::vector<Digit>& remainder) {
+  size_t n = a.size();
+  size_t m = b.size();
+  quotient.clear();
+  remainder.clear();
+  if (CompareDigits(a.data(), n, b.data(), m) < 0) {
+    remainder = a;
+  } else if (m == 1) {
+    quotient.resize(n);
+    remainder.push_back(DivModDigit(a.data(), n, b[0], quotient.data()));
+  } else if (UseBarrettDivision(n, m)) {
+    BarrettDivMod(a, b, quotient, remainder);
+  } else {
+    quotient.resize(n - m + 1);
+    remainder.resize(m);
+    KnuthDivMod(a.data(), n, b.data(), m, quotient.data(), remainder.data());
+  }
+  TrimDigits(quotient);
+  TrimDigits(remainder);
+}
+
+// floor(B^(2s) / d) for an s-limb d. Small divisors go through long division; larger ones take the
+// reciprocal of the top half (plus two guard limbs) recursively and refine it with one Newton step,
+// which leaves an error of a few units that the final correction loop removes.
+std::vector<Digit> Reciprocal(const std::vector<Digit>& d) {
+  size_t s = d.size();
+  if (s <= kReciprocalThreshold) {
+    std::vector<Digit> numerator(2 * s + 1);
+    numerator.back() = 1;
+    std::vector<Digit> quotient;
+    std::vector<Digit> remainder;
+    DivModMagnitudes(numerator, d, quotient, remainder);
+    return quotient;
+  }
+
+  size_t h = s / 2 + 2;
+  std::vector<Digit> d_high(d.end() - h, d.end());
+  std::vector<Digit> x(s - h);
+  std::vector<Digit> high_reciprocal = Reciprocal(d_high);
+  x.insert(x.end(), high_reciprocal.begin(), high_reciprocal.end());
+
+  SignedDigits one_scaled;
+  one_scaled.digits.resize(2 * s + 1);
+  one_scaled.digits.back() = 1;
+  SignedDigits divisor = MakeSigned(d.data(), s);
+  SignedDigits approximation = MakeSigned(x.data(), x.size());
+  SignedDigits error = AddSigned(one_scaled, MulSigned(divisor, approximation), true);
+  SignedDigits step = MulSigned(approximation, error);
+  step.digits.erase(step.digits.begin(), step.digits.begin() + std::min(step.digits.size(), 2 * s));
+  step.is_negative = step.is_negative && !step.digits.empty();
+  approximation = AddSigned(approximation, step);
+
+  SignedDigits remainder = AddSigned(one_scaled, MulSigned(divisor, approximation), true);
+  SignedDigits unit;
+  unit.digits.push_back(1);
+  while (remainder.is_negative) {
+    approximation = AddSigned(approximation, unit, true);
+    remainder = AddSigned(remainder, divisor);
+  }
+  while (CompareDigits(remainder.digits.data(), remainder.digits.size(), d.data(), s) >= 0) {
+    approximation = AddSigned(approximation, unit);
+    remainder = AddSigned(remainder, divisor, true);
+  }
+  return approximation.digits;
+}
+
+// Division by a large m-limb divisor in O(n / m) multiplications: the dividend is consumed m limbs at
+// a time from the top, and each step divides a value below B^(2m) with Barrett reduction.
+void BarrettDivMod(const std::vector<Digit>& a, const std::vector<Digit>& d, std::vector<Digit>& quotient,
+                   std::vector<Digit>& remainder) {
+  size_t m = d.size();
+  std::vector<Digit> reciprocal = Reciprocal(d);
+  size_t chunks = (a.size() + m - 1) / m;
+  quotient.assign(chunks * m, 0);
+  remainder.clear();
+  for (size_t chunk = chunks; chunk > 0; --chunk) {
+    size_t low = (chunk - 1) * m;
+    std::vector<Digit> current(a.begin() + low, a.begin() + std::min(a.size(), low + m));
+    current.resize(m);
+    current.insert(current.end(), remainder.begin(), remainder.end());
+    TrimDigits(current);
+
+    std::vector<Digit> high(current.begin() + std::min(current.size(), m - 1), current.end());
+    std::vector<Digit> q = MulMagnitudes(high, reciprocal);
+    q.erase(q.begin(), q.begin() + std::min(q.size(), m + 1));
+    std::vector<Digit> product = MulMagnitudes(q, d);
+    SubDigits(current.data(), current.data(), current.size(), product.data(), product.size());
+    TrimDigits(current);
+    while (CompareDigits(current.data(), current.size(), d.data(), m) >= 0) {
+      SubDigits(current.data(), current.data(), current.size(), d.data(), m);
+      TrimDigits(current);
+      IncrementDigits(q);
+    }
+    std::copy(q.begin(), q.end(), quotient.begin() + low);
+    remainder = std::move(current);
+  }
+  TrimDigits(quotient);
+}
+
+struct RadixPower {
+  // 10^(kDecimalChunkSize * 2^k) and floor(B^(2 * power.size()) / power) for Barrett division.
+  std::vector<Digit> power;
+  std::vector<Digit> reciprocal;
+};
+
+using StaticRadixPower = StaticBigInteger<kReciprocalThreshold>;
+
+constexpr StaticRadixPower MakeStaticRadixPower(size_t k) {
+  StaticRadixPower power(int64_t{kDecimalChunkMod});
+  for (size_t i = 0; i < k; ++i) {
+    power *= power;
+  }
+  return power;
+}
+
+// The powers that fit in kReciprocalThreshold limbs are built at compile time.
+constexpr StaticRadixPower kStaticRadixPowers[] = {MakeStaticRadixPower(0), MakeStaticRadixPower(1),
+                                                   MakeStaticRadixPower(2), MakeStaticRadixPower(3),
+                                                   MakeStaticRadixPower(4), MakeStaticRadixPower(5)};
+
+// Powers of ten used by the divide-and-conquer conversions, computed once and shared by all threads.
+// Elements of a deque are never moved, so returned references stay valid while the cache grows.
+const RadixPower& GetRadixPower(size_t k) {
+  static std::deque<RadixPower> cache;
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  while (cache.size() <= k) {
+    RadixPower next;
+    if (cache.size() < std::size(kStaticRadixPowers)) {
+      const StaticRadixPower& power = kStaticRadixPowers[cache.size()];
+      next.power.assign(power.data(), power.data() + power.size());
+    } else {
+      next.power = MulMagnitudes(cache.back().power, cache.back().power);
+    }
+    next.reciprocal = Reciprocal(next.power);
+    cache.push_back(std::move(next));
+  }
+  return cache[k];
+}
+
+// Barrett division of a < power^2 by a cached power of ten, costing two multiplications.
+void DivModRadixPower(const std::vector<Digit>& a, const RadixPower& radix, std::vector<Digit>& quotient,
+                      std::vector<Digit>& remainder) {
+  const std::vector<Digit>& d = radix.power;
+  size_t s = d.size();
+  std::vector<Digit> high(a.begin() + std::min(a.size(), s - 1), a.end());
+  quotient = MulMagnitudes(high, radix.reciprocal);
+  quotient.erase(quotient.begin(), quotient.begin() + std::min(quotient.size(), s + 1));
+
+  std::vector<Digit> product = MulMagnitudes(quotient, d);
+  remainder.assign(a.size(), 0);
+  SubDigits(remainder.data(), a.data(), a.size(), product.data(), product.size());
+  TrimDigits(remainder);
+  while (CompareDigits(remainder.data(), remainder.size(), d.data(), s) >= 0) {
+    SubDigits(remainder.data(), remainder.data(), remainder.size(), d.data(), s);
+    TrimDigits(remainder);
+    const Digit one = 1;
+    quotient.push_back(0);
+    AddDigits(quotient.data(), quotient.data(), quotient.size(), &one, 1);
+    TrimDigits(quotient);
+  }
+}
+
+// Parses length decimal characters, splitting at a cached power of ten above the schoolbook size.
+std::vector<Digit> ParseDecimal(const char* begin, size_t length) {
+  std::vector<Digit> result;
+  if (length <= kDecimalChunkSize * kRadixConversionThreshold) {
+    size_t chunk_length = length % kDecimalChunkSize == 0 ? kDecimalChunkSize : length % kDecimalChunkSize;
+    for (size_t i = 0; i < length; i += chunk_length, chunk_length = kDecimalChunkSize) {
+      Digit chunk = 0;
+      for (size_t j = i; j < i + chunk_length; ++j) {
+        chunk = chunk * 10 + (begin[j] - '0');
+      }
+      MulAddDigit(result, kDecimalChunkMod, chunk);
+    }
+    TrimDigits(result);
+    return result;
+  }
+
+  size_t k = 0;
+  while (kDecimalChunkSize << (k + 1) < length) {
+    ++k;
+  }
+  size_t low_length = kDecimalChunkSize << k;
+  std::vector<Digit> high;
+  std::future<void> high_task = Fork(length / kDecimalChunkSize, [&] {
+    high = ParseDecimal(begin, length - low_length);
+  });
+  std::vector<Digit> low = ParseDecimal(begin + length - low_length, low_length);
+  Join(high_task);
+  result = MulMagnitudes(high, GetRadixPower(k).power);
+  if (result.size() < low.size()) {
+    result.resize(low.size());
+  }
+  result.push_back(0);
+  AddDigits(result.data(), result.data(), result.size(), low.data(), low.size());
+  TrimDigits(result);
+  return result;
+}
+
+// Writes value < 10^width as exactly width zero-padded digits; width is kDecimalChunkSize * 2^k.
+void WriteDecimal(std::vector<Digit> value, size_t width, char* out) {
+  if (width <= kDecimalChunkSize * kRadixConversionThreshold) {
+    for (size_t end = width; end > 0; end -= kDecimalChunkSize) {
+      WriteChunk(out + end - kDecimalChunkSize, DivDigit(value, kDecimalChunkMod));
+    }
+    return;
+  }
+
+  size_t half = width / 2;
+  size_t k = 0;
+  while (kDecimalChunkSize << k < half) {
+    ++k;
+  }
+  std::vector<Digit> quotient;
+  std::vector<Digit> remainder;
+  DivModRadixPower(value, GetRadixPower(k), quotient, remainder);
+  value.clear();
+  std::future<void> high_task = Fork(half / kDecimalChunkSize, [&] {
+    WriteDecimal(std::move(quotient), half, out);
+  });
+  WriteDecimal(std::move(remainder), half, out + half);
+  Join(high_task);
+}
+
+// Multiplies a by b modulo an odd m in Montgomery form, where residues hold x * B^k mod m. Reduction is
+// word-by-word REDC over a scratch product kept between calls.
+class MontgomeryReducer {
+ public:
+  explicit MontgomeryReducer(const std::vector<Digit>& modulus)
+      : modulus_(modulus), size_(modulus.size()), product_(2 * size_ + 1) {
+    // m[0] is its own inverse modulo 2^3 and every Newton step doubles the number of correct bits.
+    Digit inverse = modulus_[0];
+    for (int i = 0; i < 4; ++i) {
+      inverse *= 2 - modulus_[0] * inverse;
+    }
+    inverse_ = 0 - inverse;
+
+    std::vector<Digit> power(2 * size_ + 1);
+    power.back() = 1;
+    std::vector<Digit> quotient;
+    DivModMagnitudes(power, modulus_, quotient, r_squared_);
+    r_squared_.resize(size_);
+  }
+
+  [[nodiscard]] size_t Size() const {
+    return size_;
+  }
+
+  // out = a * b / B^k mod m; out may alias a or b.
+  void Mul(const Digit* a, const Digit* b, Digit* out) {
+    MulDigits(a, size_, b, size_, product_.data());
+    product_.back() = 0;
+    Reduce(out);
+  }
+
+  void ToResidue(const Digit* a, Digit* out) {
+    Mul(a, r_squared_.data(), out);
+  }
+
+  void FromResidue(const Digit* a, Digit* out) {
+    std::copy(a, a + size_, product_.begin());
+    std::fill(product_.begin() + size_, product_.end(), 0);
+    Reduce(out);
+  }
+
+ private:
+  void Reduce(Digit* out) {
+    Digit* t = product_.data();
+    const Digit* m = modulus_.data();
+    size_t k = size_;
+    for (size_t i = 0; i < k; ++i) {
+      Digit u = t[i] * inverse_;
+      DoubleDigit carry = 0;
+      for (size_t j = 0; j < k; ++j) {
+        carry += static_cast<DoubleDigit>(u) * m[j] + t[i + j];
+        t[i + j] = static_cast<Digit>(carry);
+        carry >>= BigInteger::digit_bits;
+      }
+      for (size_t j = i + k; carry != 0; ++j) {
+        carry += t[j];
+        t[j] = static_cast<Digit>(carry);
+        carry >>= BigInteger::digit_bits;
+      }
+    }
+    // The upper half is now below 2m, so one conditional subtraction finishes the reduction.
+    Digit* high = t + size_;
+    if (high[size_] != 0 || CompareDigits(high, size_, modulus_.data(), size_) >= 0) {
+      SubDigits(out, high, size_, modulus_.data(), size_);
+    } else {
+      std::copy(high, high + size_, out);
+    }
+  }
+
+  std::vector<Digit> modulus_;
+  size_t size_;
+  Digit inverse_;  // -m^-1 mod B
+  std::vector<Digit> r_squared_;  // B^(2k) mod m
+  std::vector<Digit> product_;
+};
+
+// Multiplies a by b modulo any m with Barrett reduction against floor(B^(2k) / m); residues are plain
+// values below m. The quotient estimate is at most two below the true one.
+class BarrettReducer {
+ public:
+  explicit BarrettReducer(const std::vector<Digit>& modulus)
+      : modulus_(modulus), size_(modulus.size()), reciprocal_(Reciprocal(modulus)),
+        product_(2 * size_), estimate_(size_ + 1 + reciprocal_.size()), back_(2 * size_) {
+  }
+
+  [[nodiscard]] size_t Size() const {
+    return size_;
+  }
+
+  // out = a * b mod m; out may alias a or b.
+  void Mul(const Digit* a, const Digit* b, Digit* out) {
+    MulDigits(a, size_, b, size_, product_.data());
+    Reduce(out);
+  }
+
+  void ToResidue(const Digit* a, Digit* out) {
+    std::copy(a, a + size_, out);
+  }
+
+  void FromResidue(const Digit* a, Digit* out) {
+    std::copy(a, a + size_, out);
+  }
+
+ private:
+  void Reduce(Digit* out) {
+    // B^(k-1) <= m < B^k makes the reciprocal k + 1 limbs, or k + 2 for m == B^(k-1); either way it is
+    // at least as long as the k + 1 high limbs of the product, and the quotient estimate fits in k limbs.
+    MulDigits(reciprocal_.data(), reciprocal_.size(), product_.data() + size_ - 1, size_ + 1, estimate_.data());
+    MulDigits(estimate_.data() + size_ + 1, size_, modulus_.data(), size_, back_.data());
+    SubDigits(product_.data(), product_.data(), 2 * size_, back_.data(), 2 * size_);
+    while (product_[size_] != 0 || CompareDigits(product_.data(), size_, modulus_.data(), size_) >= 0) {
+      SubDigits(product_.data(), product_.data(), size_ + 1, modulus_.data(), size_);
+    }
+    std::copy(product_.begin(), product_.begin() + size_, out);
+  }
+
+  std::vector<Digit> modulus_;
+  size_t size_;
+  std::vector<Digit> reciprocal_;
+  std::vector<Digit> product_;
+  std::vector<Digit> estimate_;
+  std::vector<Digit> back_;
+};
+
+// Window width for sliding-window exponentiation, trading the table of odd powers against the
+// multiplications saved per exponent bit.
+size_t WindowBits(size_t exponent_bits) {
+  size_t window = 2;
+  for (size_t limit : {24, 80, 240, 672}) {
+    if (exponent_bits > limit) {
+      ++window;
+    }
+  }
+  return window;
+}
+
+// out = base^exponent for a residue base and a non-zero exponent, scanning the exponent from the top
+// in windows that start and end with a set bit.
+template <class Reducer>
+void SlidingWindowPow(Reducer& reducer, const Digit* base, const Digit* exponent, size_t exponent_size,
+                      Digit* out) {
+  size_t k = reducer.Size();
+  size_t bits = (exponent_size - 1) * BigInteger::digit_bits + CountBits(exponent[exponent_size - 1]);
+  size_t window = WindowBits(bits);
+  auto bit = [exponent](size_t i) {
+    return (exponent[i / BigInteger::digit_bits] >> (i % BigInteger::digit_bits)) & 1;
+  };
+
+  // table[j] = base^(2j + 1)
+  size_t table_size = size_t{1} << (window - 1);
+  std::vector<Digit> table(table_size * k);
+  std::copy(base, base + k, table.begin());
+  if (table_size > 1) {
+    std::vector<Digit> square(k);
+    reducer.Mul(base, base, square.data());
+    for (size_t j = 1; j < table_size; ++j) {
+      reducer.Mul(&table[(j - 1) * k], square.data(), &table[j * k]);
+    }
+  }
+
+  bool started = false;
+  for (size_t i = bits; i > 0;) {
+    if (bit(i - 1) == 0) {
+      reducer.Mul(out, out, out);
+      --i;
+      continue;
+    }
+    size_t low = i > window ? i - window : 0;
+    while (bit(low) == 0) {
+      ++low;
+    }
+    size_t value = 0;
+    for (size_t j = i; j > low; --j) {
+      value = value << 1 | bit(j - 1);
+    }
+    const Digit* power = &table[(value >> 1) * k];
+    if (started) {
+      for (size_t j = low; j < i; ++j) {
+        reducer.Mul(out, out, out);
+      }
+      reducer.Mul(out, power, out);
+    } else {
+      std::copy(power, power + k, out);
+      started = true;
+    }
+    i = low;
+  }
+}
+
+template <class Reducer>
+void PowResidue(const std::vector<Digit>& modulus, std::vector<Digit>& value, const Digit* exponent,
+                size_t exponent_size) {
+  Reducer reducer(modulus);
+  std::vector<Digit> base(value.size());
+  reducer.ToResidue(value.data(), base.data());
+  SlidingWindowPow(reducer, base.data(), exponent, exponent_size, value.data());
+  reducer.FromResidue(value.data(), value.data());
+}
+
+size_t BitLength(const std::vector<Digit>& digits) {
+  return digits.empty() ? 0 : (digits.size() - 1) * BigInteger::digit_bits + CountBits(digits.back());
+}
+
+DoubleDigit ToDoubleDigit(const std::vector<Digit>& digits) {
+  DoubleDigit value = 0;
+  for (size_t i = digits.size(); i > 0; --i) {
+    value = value << BigInteger::digit_bits | digits[i - 1];
+  }
+  return value;
+}
+
+// Bits [shift, shift + 64) of digits; only called where everything above them is zero.
+DoubleDigit ExtractBits(const std::vector<Digit>& digits, size_t shift) {
+  auto limb = [&digits](size_t i) -> DoubleDigit {
+    return i < digits.size() ? digits[i] : 0;
+  };
+  size_t index = shift / BigInteger::digit_bits;
+  size_t offset = shift % BigInteger::digit_bits;
+  DoubleDigit value = (limb(index + 1) << BigInteger::digit_bits | limb(index)) >> offset;
+  if (offset != 0) {
+    value |= limb(index + 2) << (2 * BigInteger::digit_bits - offset);
+  }
+  return value;
+}
+
+DoubleDigit BinaryGcd(DoubleDigit a, DoubleDigit b) {
+  if (a == 0 || b == 0) {
+    return a | b;
+  }
+  size_t shift = 0;
+  while (((a | b) & 1) == 0) {
+    a >>= 1;
+    b >>= 1;
+    ++shift;
+  }
+  while ((a & 1) == 0) {
+    a >>= 1;
+  }
+  while (b != 0) {
+    while ((b & 1) == 0) {
+      b >>= 1;
+    }
+    if (a > b) {
+      std::swap(a, b);
+    }
+    b -= a;
+  }
+  return a << shift;
+}
+
+SignedDigits MakeSigned(int64_t value) {
+  Digit digits[2];
+  SignedDigits result = MakeSigned(digits, SplitInt64(value, digits));
+  result.is_negative = value < 0;
+  return result;
+}
+
+// x * a + y * b
+SignedDigits Combine(const SignedDigits& a, int64_t x, const SignedDigits& b, int64_t y) {
+  return AddSigned(MulSigned(a, MakeSigned(x)), MulSigned(b, MakeSigned(y)));
+}
+
+// Cofactor matrix of several Euclid steps: (a, b) becomes (a * a + b * b, c * a + d * b).
+struct LehmerMatrix {
+  int64_t a = 1;
+  int64_t b = 0;
+  int64_t c = 0;
+  int64_t d = 1;
+};
+
+const size_t kLehmerBits = 62;
+
+// Runs Euclid on the leading kLehmerBits bits of a >= b for as long as the quotients provably match
+// those of the full values (Knuth's Algorithm L). b == 0 in the result means no step was certain.
+LehmerMatrix LehmerCosequence(const std::vector<Digit>& a, const std::vector<Digit>& b) {
+  size_t shift = BitLength(a) - kLehmerBits;
+  auto x = static_cast<int64_t>(ExtractBits(a, shift));
+  auto y = static_cast<int64_t>(ExtractBits(b, shift));
+  LehmerMatrix matrix;
+  while (y + matrix.c > 0 && y + matrix.d > 0) {
+    int64_t q = (x + matrix.a) / (y + matrix.c);
+    if (q != (x + matrix.b) / (y + matrix.d)) {
+      break;
+    }
+    int64_t t = matrix.a - q * matrix.c;
+    matrix.a = matrix.c;
+    matrix.c = t;
+    t = matrix.b - q * matrix.d;
+    matrix.b = matrix.d;
+    matrix.d = t;
+    t = x - q * y;
+    x = y;
+    y = t;
+  }
+  return matrix;
+}
+
+// Cofactors u of the first operand for the current pair: a = u * a_0 + v * b_0 for some integer v.
+struct GcdCofactors {
+  SignedDigits current;
+  SignedDigits next;
+};
+
+// Replaces a >= b with (gcd(a, b), 0) by Lehmer's algorithm, falling back to a full division step
+// whenever the leading bits cannot decide the quotient. Once both values fit in two limbs the plain gcd
+// finishes with binary GCD; cofactor tracking instead continues with ordinary Euclid steps.
+void LehmerGcd(SignedDigits& a, SignedDigits& b, GcdCofactors* cofactors) {
+  while (!b.digits.empty()) {
+    size_t bits = BitLength(a.digits);
+    if (bits <= 2 * BigInteger::digit_bits && cofactors == nullptr) {
+      DoubleDigit gcd = BinaryGcd(ToDoubleDigit(a.digits), ToDoubleDigit(b.digits));
+      a.digits = {static_cast<Digit>(gcd), static_cast<Digit>(gcd >> BigInteger::digit_bits)};
+      TrimDigits(a.digits);
+      b.digits.clear();
+      return;
+    }
+
+    LehmerMatrix matrix;
+    if (bits > 2 * BigInteger::digit_bits) {
+      matrix = LehmerCosequence(a.digits, b.digits);
+    }
+    if (matrix.b == 0) {
+      std::vector<Digit> quotient;
+      std::vector<Digit> remainder;
+      DivModMagnitudes(a.digits, b.digits, quotient, remainder);
+      a.digits.swap(b.digits);
+      b.digits.swap(remainder);
+      if (cofactors != nullptr) {
+        SignedDigits next = AddSigned(cofactors->current, MulSigned(MakeSigned(quotient.data(), quotient.size()),
+                                                                    cofactors->next), true);
+        cofactors->current = std::move(cofactors->next);
+        cofactors->next = std::move(next);
+      }
+      continue;
+    }
+
+    SignedDigits next_a = Combine(a, matrix.a, b, matrix.b);
+    b = Combine(a, matrix.c, b, matrix.d);
+    a = std::move(next_a);
+    if (cofactors != nullptr) {
+      SignedDigits current = Combine(cofactors->current, matrix.a, cofactors->next, matrix.b);
+      cofactors->next = Combine(cofactors->current, matrix.c, cofactors->next, matrix.d);
+      cofactors->current = std::move(current);
+    }
+  }
+}
+
+std::vector<Digit> ShiftBitsLeft(const std::vector<Digit>& a, size_t shift) {
+  if (a.empty()) {
+    return {};
+  }
+  size_t limbs = shift / BigInteger::digit_bits;
+  std::vector<Digit> result(limbs + a.size() + 1);
+  result.back() = ShiftLeftDigits(result.data() + limbs, a.data(), a.size(), shift % BigInteger::digit_bits);
+  TrimDigits(result);
+  return result;
+}
+
+std::vector<Digit> ShiftBitsRight(const std::vector<Digit>& a, size_t shift) {
+  size_t limbs = shift / BigInteger::digit_bits;
+  if (limbs >= a.size()) {
+    return {};
+  }
+  std::vector<Digit> result(a.size() - limbs);
+  ShiftRightDigits(result.data(), a.data() + limbs, result.size(), shift % BigInteger::digit_bits);
+  TrimDigits(result);
+  return result;
+}
+
+std::vector<Digit> PowMagnitude(const std::vector<Digit>& a, size_t exponent) {
+  std::vector<Digit> result = {1};
+  std::vector<Digit> power = a;
+  for (; exponent != 0; exponent >>= 1) {
+    if (exponent & 1) {
+      result = MulMagnitudes(result, power);
+    }
+    if (exponent > 1) {
+      power = MulMagnitudes(power, power);
+    }
+  }
+  return result;
+}
+
+// root^k <= value without overflowing.
+bool PowerAtMost(DoubleDigit root, size_t k, DoubleDigit value) {
+  DoubleDigit power = 1;
+  for (size_t i = 0; i < k; ++i) {
+    if (root != 0 && power > value / root) {
+      return false;
+    }
+    power *= root;
+  }
+  return true;
+}
+
+// floor(value^(1/k)) for k >= 2 by bisection; the root has at most digit_bits bits.
+DoubleDigit RootDoubleDigit(DoubleDigit value, size_t k) {
+  DoubleDigit low = 0;
+  DoubleDigit high = DoubleDigit{1} << BigInteger::digit_bits;
+  while (high - low > 1) {
+    DoubleDigit middle = low + (high - low) / 2;
+    if (PowerAtMost(middle, k, value)) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+// floor(a^(1/k)) for k >= 2 by Newton's method with precision doubling. The root of a >> (k * s) for
+// s = bits / (2k) is computed recursively, and one more than it, shifted back by s bits, bounds the root
+// from above with its top half already correct. Newton steps from above then only have to fix the low
+// half, which usually takes a single division.
+std::vector<Digit> RootMagnitude(const std::vector<Digit>& a, size_t k) {
+  if (a.empty()) {
+    return {};
+  }
+  size_t bits = BitLength(a);
+  if (k >= bits) {
+    return {1};
+  }
+  if (bits <= 2 * BigInteger::digit_bits) {
+    return {static_cast<Digit>(RootDoubleDigit(ToDoubleDigit(a), k))};
+  }
+  size_t s = bits / (2 * k);
+  if (s == 0) {
+    // The root is below 2^(bits / k) <= 4.
+    Digit root = 3;
+    for (;; --root) {
+      std::vector<Digit> power = PowMagnitude({root}, k);
+      if (CompareDigits(power.data(), power.size(), a.data(), a.size()) <= 0) {
+        return {root};
+      }
+    }
+  }
+
+  std::vector<Digit> x = RootMagnitude(ShiftBitsRight(a, k * s), k);
+  IncrementDigits(x);
+  x = ShiftBitsLeft(x, s);
+  std::vector<Digit> quotient;
+  std::vector<Digit> remainder;
+  while (true) {
+    // next = ((k - 1) * x + a / x^(k - 1)) / k
+    DivModMagnitudes(a, PowMagnitude(x, k - 1), quotient, remainder);
+    std::vector<Digit> next = x;
+    MulAddDigit(next, static_cast<Digit>(k - 1), 0);
+    next.resize(std::max(next.size(), quotient.size()) + 1);
+    AddDigits(next.data(), next.data(), next.size(), quotient.data(), quotient.size());
+    DivDigit(next, static_cast<Digit>(k));
+    if (CompareDigits(next.data(), next.size(), x.data(), x.size()) >= 0) {
+      return x;
+    }
+    x = std::move(next);
+    // Newton steps never go below the root, so once x^k fits under a, x is the root.
+    std::vector<Digit> power = PowMagnitude(x, k);
+    if (CompareDigits(power.data(), power.size(), a.data(), a.size()) <= 0) {
+      return x;
+    }
+  }
+}
+
+// Limb of the two's complement form of a sign-magnitude value, streamed from the bottom: -x = ~(x - 1),
+// with borrow starting at 1 and carrying the "- 1" upwards.
+Digit TwosComplementDigit(Digit digit, bool is_negative, Digit& borrow) {
+  if (!is_negative) {
+    return digit;
+  }
+  Digit value = digit - borrow;
+  borrow &= digit == 0;
+  return ~value;
+}
+
+const size_t kLimbBytes = sizeof(Digit);
+
+size_t VarintSize(size_t value) {
+  size_t size = 1;
+  for (; value >= 0x80; value >>= 7) {
+    ++size;
+  }
+  return size;
+}
+
+// Binomial(n, k) sieves primes up to n only while n <= kBinomialSieveRatio * k; for smaller k the
+// sieve would cost far more than dividing the k-term falling factorial by k!.
+const uint32_t kBinomialSieveRatio = 256;
+
+// Appends factor to the pending single-limb product, flushing it to factors when it would overflow.
+void PackFactor(Digit factor, DoubleDigit& packed, std::vector<BigInteger>& factors) {
+  if (packed * factor > std::numeric_limits<Digit>::max()){
+    factors.emplace_back(static_cast<int64_t>(packed));
+    packed = 1;
+  }
+  packed *= factor;
+}
+
+BigInteger PackedProduct(DoubleDigit packed, std::vector<BigInteger>& factors) {
+  if (packed != 1){
+    factors.emplace_back(static_cast<int64_t>(packed));
+  }
+  return ProductTree(factors.data(), factors.size());
+}
+}  // namespace
 
 void RemoveLeadingZeros(BigInteger& number){
-  while(number.digits_.end()[-1] == 0 && number.digits_.size() != 1){
+  while(!number.digits_.empty() && number.digits_.back() == 0){
     number.digits_.pop_back();
   }
+  if (number.digits_.empty()){
+    number.is_negative_ = false;
+  }
+}
+
+void CheckOverflow(const BigInteger& number){
+  if (number.digits_.empty()){
+    return;
+  }
+
+  size_t bits = (number.digits_.size() - 1) * BigInteger::digit_bits + CountBits(number.digits_.back());
+  if (static_cast<double>(bits - 1) * kLog10Of2 >= BigInteger::digit_max_size){
+    throw BigIntegerOverflow{};
+  }
 }
 
 BigInteger::BigInteger(int64_t n) {
-  if (n < 0){
-    is_negative_ = true;
-    n *= -1;
-  } else if (n == 0){
-    digits_.push_back(0);
-  }
-
-  while(n > 0) {
-    DigitType digit = 0;
-    digit += n%digit_mod;
-    n /= digit_mod;
-    digits_.push_back(digit);
+  is_negative_ = n < 0;
+  DoubleDigitType magnitude = is_negative_ ? 0 - static_cast<DoubleDigitType>(n) : static_cast<DoubleDigitType>(n);
+  while(magnitude > 0) {
+    digits_.push_back(static_cast<DigitType>(magnitude));
+    magnitude >>= digit_bits;
   }
 }
 
 BigInteger::BigInteger(int32_t num) : BigInteger(static_cast<int64_t>(num)) {}
 
 BigInteger::BigInteger(const char *char_arr) {
-  std::string string = char_arr;
-  if (char_arr[0] == '-'){
-    is_negative_ = true;
-  }
-
-  for (auto it = string.crbegin(); it != string.crend() - (char_arr[0] == '-' || char_arr[0] == '+'); ++it) {
-    DigitType digit = *it - '0';
-    size_t i = 0;
-    while(i != 2){
-      ++it;
-      if (it == string.crend() - (char_arr[0] == '-' || char_arr[0] == '+')){
-        break;
-      }
-      digit = digit + (*it - '0') * static_cast<DigitType>(std::pow(10, i+1));
-      ++i;
-    }
-    digits_.push_back(digit);
-    if (it == string.crend() - (char_arr[0] == '-' || char_arr[0] == '+')){
-      break;
-    }
-  }
+  bool has_sign = char_arr[0] == '-' || char_arr[0] == '+';
+  is_negative_ = char_arr[0] == '-';
+  const char* begin = char_arr + has_sign;
+  std::vector<Digit> digits = ParseDecimal(begin, std::strlen(begin));
+  digits_.assign(digits.begin(), digits.end());
+  RemoveLeadingZeros(*this);
 }
 
 bool BigInteger::IsNegative() const {
@@ -62,33 +1419,32 @@ BigInteger BigInteger::operator+() const {
 
 BigInteger BigInteger::operator-() const {
   BigInteger big_integer = *this;
-  big_integer.is_negative_ = !big_integer.is_negative_;
+  big_integer.is_negative_ = !big_integer.is_negative_ && !big_integer.digits_.empty();
   return big_integer;
 }
 
 std::ostream &operator<<(std::ostream &ostream, const BigInteger &other) {
-  if (other.is_negative_){
-    ostream << '-';
+  if (other.digits_.empty()){
+    return ostream << '0';
   }
 
-  for (auto it = other.digits_.crbegin(); it != other.digits_.crend(); ++it) {
-    if (it == other.digits_.crbegin()){
-      ostream << *it;
-      continue;
-    }
-
-    if (*it == 0){
-      ostream << "000";
-    } else if (*it / 10 == 0){
-      ostream << "00" + std::to_string(*it);
-    } else if (*it / 100 == 0){
-      ostream << "0" + std::to_string(*it);
-    } else {
-      ostream << *it;
-    }
+  size_t bits = (other.digits_.size() - 1) * BigInteger::digit_bits + CountBits(other.digits_.back());
+  size_t max_length = static_cast<size_t>(static_cast<double>(bits) * kLog10Of2) + 1;
+  size_t width = kDecimalChunkSize;
+  while (width < max_length){
+    width *= 2;
   }
 
-  return ostream;
+  std::string buffer(width + 1, '0');
+  WriteDecimal(std::vector<Digit>(other.digits_.begin(), other.digits_.end()), width, &buffer[1]);
+  size_t first = 1;
+  while (buffer[first] == '0'){
+    ++first;
+  }
+  if (other.is_negative_){
+    buffer[--first] = '-';
+  }
+  return ostream.write(buffer.data() + first, static_cast<std::streamsize>(buffer.size() - first));
 }
 
 std::istream &operator>>(std::istream &istream, BigInteger &other) {
@@ -98,129 +1454,56 @@ std::istream &operator>>(std::istream &istream, BigInteger &other) {
   return istream;
 }
 
-BigInteger operator+(const BigInteger &l, const BigInteger &r) {
+BigInteger BigInteger::Sum(const BigInteger &l, const BigInteger &r, bool subtract) {
+  bool r_is_negative = r.is_negative_ != subtract && !r.digits_.empty();
+  size_t n = l.digits_.size();
+  size_t m = r.digits_.size();
   BigInteger result;
 
-  if (l.is_negative_ == r.is_negative_){
-    result.is_negative_ = l.is_negative_;
-    BigInteger::DigitType carry = 0;
-    size_t i = 0;
-    while(i < std::min(l.digits_.size(), r.digits_.size())){
-      BigInteger::DigitType digit = l.digits_[i] + r.digits_[i] + carry;
-      if (digit < BigInteger::digit_mod){
-        result.digits_.push_back(digit);
-        carry = 0;
-      } else {
-        digit -= BigInteger::digit_mod;
-        result.digits_.push_back(digit);
-        carry = 1;
-      }
-      ++i;
-    }
-
-    while(i < l.digits_.size()){
-      BigInteger::DigitType digit = l.digits_[i] + carry;
-      if (digit < BigInteger::digit_mod){
-        result.digits_.push_back(digit);
-        carry = 0;
-      } else {
-        digit -= BigInteger::digit_mod;
-        result.digits_.push_back(digit);
-        carry = 1;
-      }
-      ++i;
-    }
-
-    while(i < r.digits_.size()){
-      BigInteger::DigitType digit = r.digits_[i] + carry;
-      if (digit < BigInteger::digit_mod){
-        result.digits_.push_back(digit);
-        carry = 0;
-      } else {
-        digit -= BigInteger::digit_mod;
-        result.digits_.push_back(digit);
-        carry = 1;
-      }
-      ++i;
-    }
-
-    if (carry == 1){
-      result.digits_.push_back(1);
-    }
+  if (l.is_negative_ == r_is_negative || n == 0 || m == 0){
+    result.is_negative_ = n != 0 ? l.is_negative_ : r_is_negative;
+    const BigInteger& bigger = n >= m ? l : r;
+    const BigInteger& smaller = n >= m ? r : l;
+    result.digits_.resize(bigger.digits_.size() + 1);
+    result.digits_.back() = AddDigits(result.digits_.data(), bigger.digits_.data(), bigger.digits_.size(),
+                                      smaller.digits_.data(), smaller.digits_.size());
   } else {
-    if (l == -r){
-      return 0;
-    }
-
-    bool abs_l_is_bigger = l.is_negative_ ? -l > r : l > -r;
-    result.is_negative_ = l.is_negative_ == abs_l_is_bigger;
-    BigInteger::DigitType carry = 0;
-    size_t i = 0;
-    while(i < std::min(l.digits_.size(), r.digits_.size())){
-      BigInteger::DigitType digit = 0;
-      if (abs_l_is_bigger) {
-        if (l.digits_[i] < r.digits_[i] +carry){
-          digit = BigInteger::digit_mod + l.digits_[i] - r.digits_[i] - carry;
-          carry = 1;
-        } else {
-          digit = l.digits_[i] - r.digits_[i] - carry;
-          carry = 0;
-        }
-      } else {
-        if (r.digits_[i] < l.digits_[i] + carry){
-          digit = BigInteger::digit_mod + r.digits_[i] - l.digits_[i] - carry;
-          carry = 1;
-        } else{
-          digit = r.digits_[i] - l.digits_[i] - carry;
-          carry = 0;
-        }
-      }
-
-      result.digits_.push_back(digit);
-      ++i;
-    }
-
-    while(i < l.digits_.size()){
-      BigInteger::DigitType digit = l.digits_[i] - carry;
-      if (digit != 0){
-        result.digits_.push_back(digit);
-      }
-      ++i;
+    int cmp = CompareDigits(l.digits_.data(), n, r.digits_.data(), m);
+    if (cmp == 0){
+      return result;
     }
 
-    while(i < r.digits_.size()){
-      BigInteger::DigitType digit = r.digits_[i] - carry;
-      if (digit != 0){
-        result.digits_.push_back(digit);
-      }
-      ++i;
-    }
+    result.is_negative_ = cmp > 0 ? l.is_negative_ : r_is_negative;
+    const BigInteger& bigger = cmp > 0 ? l : r;
+    const BigInteger& smaller = cmp > 0 ? r : l;
+    result.digits_.resize(bigger.digits_.size());
+    SubDigits(result.digits_.data(), bigger.digits_.data(), bigger.digits_.size(), smaller.digits_.data(),
+              smaller.digits_.size());
   }
 
   RemoveLeadingZeros(result);
-  if (result.digits_.size() * 3 > BigInteger::digit_max_size){
-    throw BigIntegerOverflow{};
-  }
+  CheckOverflow(result);
   return result;
 }
 
+BigInteger operator+(const BigInteger &l, const BigInteger &r) {
+  return BigInteger::Sum(l, r, false);
+}
+
 BigInteger operator*(const BigInteger &l, const BigInteger &r) {
+  if (l.digits_.empty() || r.digits_.empty()){
+    return 0;
+  }
+
+  const auto& bigger = l.digits_.size() >= r.digits_.size() ? l.digits_ : r.digits_;
+  const auto& smaller = l.digits_.size() >= r.digits_.size() ? r.digits_ : l.digits_;
   BigInteger result;
   result.digits_.resize(l.digits_.size() + r.digits_.size());
-  for (size_t i = 0; i < l.digits_.size(); ++i) {
-    BigInteger::DigitType carry = 0;
-    for (size_t j = 0; j < r.digits_.size() || carry != 0; ++j) {
-      BigInteger::DigitType cur = result.digits_[i + j] + l.digits_[i] * (j < r.digits_.size() ? r.digits_[j] : 0) + carry;
-      result.digits_[i + j] = cur % BigInteger::digit_mod;
-      carry = cur / BigInteger::digit_mod;
-    }
-  }
+  MulDigits(bigger.data(), bigger.size(), smaller.data(), smaller.size(), result.digits_.data());
 
   RemoveLeadingZeros(result);
-  result.is_negative_ = l.is_negative_ != r.is_negative_ && result != 0;
-  if (result.digits_.size() * 3 > BigInteger::digit_max_size){
-    throw BigIntegerOverflow{};
-  }
+  result.is_negative_ = l.is_negative_ != r.is_negative_;
+  CheckOverflow(result);
   return result;
 }
 
@@ -230,21 +1513,8 @@ bool operator<(const BigInteger &l, const BigInteger &r) {
     return l.is_negative_;
   }
 
-  if (l.digits_.size() != r.digits_.size()){
-    return (l.digits_.size() < r.digits_.size() && !l.is_negative_) || (l.digits_.size() > r.digits_.size() && l.is_negative_);
-  }
-
-  for (int i = static_cast<int>(l.digits_.size()-1); i >= 0; --i) {
-    if ((l.digits_[i] < r.digits_[i] && !l.is_negative_) || (l.digits_[i] > r.digits_[i] && l.is_negative_)){
-      return true;
-    }
-
-    if (l.digits_[i] > r.digits_[i]){
-      return false;
-    }
-  }
-
-  return false;
+  int cmp = CompareDigits(l.digits_.data(), l.digits_.size(), r.digits_.data(), r.digits_.size());
+  return l.is_negative_ ? cmp > 0 : cmp < 0;
 }
 bool operator>(const BigInteger &l, const BigInteger &r) {
   return r < l;
@@ -259,17 +1529,39 @@ bool operator==(const BigInteger &l, const BigInteger &r) {
     return false;
   }
 
-  for (size_t i = 0; i < l.digits_.size(); ++i) {
-    if (l.digits_[i] != r.digits_[i]){
-      return false;
-    }
-  }
-
-  return true;
+  return EqualDigits(l.digits_.data(), r.digits_.data(), l.digits_.size());
 }
 bool operator!=(const BigInteger &l, const BigInteger &r) {
   return !(l == r);
 }
+int CompareWithInt64(const BigInteger &l, int64_t r) {
+  if (l.is_negative_ != (r < 0)){
+    return l.is_negative_ ? -1 : 1;
+  }
+
+  Digit digits[2];
+  size_t size = SplitInt64(r, digits);
+  int cmp = CompareDigits(l.digits_.data(), l.digits_.size(), digits, size);
+  return l.is_negative_ ? -cmp : cmp;
+}
+bool operator<(const BigInteger &l, int64_t r) {
+  return CompareWithInt64(l, r) < 0;
+}
+bool operator<=(const BigInteger &l, int64_t r) {
+  return CompareWithInt64(l, r) <= 0;
+}
+bool operator>(const BigInteger &l, int64_t r) {
+  return CompareWithInt64(l, r) > 0;
+}
+bool operator>=(const BigInteger &l, int64_t r) {
+  return CompareWithInt64(l, r) >= 0;
+}
+bool operator==(const BigInteger &l, int64_t r) {
+  return CompareWithInt64(l, r) == 0;
+}
+bool operator!=(const BigInteger &l, int64_t r) {
+  return CompareWithInt64(l, r) != 0;
+}
 bool operator<=(const BigInteger &l, const BigInteger &r) {
   return l < r || l == r;
 }
@@ -277,92 +1569,652 @@ bool operator>=(const BigInteger &l, const BigInteger &r) {
   return l > r || l == r;
 }
 BigInteger operator-(const BigInteger &l, const BigInteger &r) {
-  return l + (-r);
+  return BigInteger::Sum(l, r, true);
+}
+BigInteger &BigInteger::AddInPlace(const DigitType *digits, size_t size, bool is_negative) {
+  bool other_is_negative = is_negative && size != 0;
+  size_t n = digits_.size();
+  if (is_negative_ == other_is_negative || n == 0){
+    is_negative_ = other_is_negative || (is_negative_ && n != 0);
+    if (n < size){
+      digits_.resize(size);
+    }
+    Digit carry = AddDigits(digits_.data(), digits_.data(), digits_.size(), digits, size);
+    if (carry != 0){
+      digits_.push_back(carry);
+    }
+  } else if (CompareDigits(digits_.data(), n, digits, size) >= 0){
+    SubDigits(digits_.data(), digits_.data(), n, digits, size);
+  } else {
+    digits_.resize(size);
+    SubDigits(digits_.data(), digits, size, digits_.data(), n);
+    is_negative_ = other_is_negative;
+  }
+
+  RemoveLeadingZeros(*this);
+  CheckOverflow(*this);
+  return *this;
+}
+
+BigInteger &BigInteger::MulInPlace(const DigitType *digits, size_t size, bool is_negative) {
+  if (digits_.empty() || size == 0){
+    digits_.clear();
+    is_negative_ = false;
+    return *this;
+  }
+
+  // The product is built in a per-thread scratch buffer whose storage is then exchanged with ours, so
+  // repeated *= on values of similar size stops allocating once both buffers have grown.
+  static thread_local LimbBuffer scratch;
+  size_t n = digits_.size();
+  scratch.resize(n + size);
+  if (n >= size){
+    MulDigits(digits_.data(), n, digits, size, scratch.data());
+  } else {
+    MulDigits(digits, size, digits_.data(), n, scratch.data());
+  }
+  digits_.swap(scratch);
+  is_negative_ = is_negative_ != is_negative;
+  RemoveLeadingZeros(*this);
+  CheckOverflow(*this);
+  return *this;
 }
+
 BigInteger &BigInteger::operator++() {
-  *this += 1;
+  if (is_negative_){
+    DecrementDigits(digits_);
+    RemoveLeadingZeros(*this);
+  } else {
+    IncrementDigits(digits_);
+    CheckOverflow(*this);
+  }
   return *this;
 }
 
 BigInteger BigInteger::operator++(int) {
   auto big_integer = *this;
-  *this += 1;
+  ++*this;
   return big_integer;
 }
 
 BigInteger &BigInteger::operator--() {
-  *this -= 1;
+  if (is_negative_){
+    IncrementDigits(digits_);
+    CheckOverflow(*this);
+  } else if (digits_.empty()){
+    digits_.push_back(1);
+    is_negative_ = true;
+  } else {
+    DecrementDigits(digits_);
+    RemoveLeadingZeros(*this);
+  }
   return *this;
 }
 
 BigInteger BigInteger::operator--(int) {
   auto big_integer = *this;
-  *this -= 1;
+  --*this;
   return big_integer;
 }
 BigInteger &BigInteger::operator+=(const BigInteger &other) {
-  *this = *this + other;
-  return *this;
+  return AddInPlace(other.digits_.data(), other.digits_.size(), other.is_negative_);
 }
 BigInteger &BigInteger::operator*=(const BigInteger &other) {
-  *this = *this * other;
-  return *this;
+  return MulInPlace(other.digits_.data(), other.digits_.size(), other.is_negative_);
 }
 BigInteger &BigInteger::operator-=(const BigInteger &other) {
-  *this = *this - other;
-  return *this;
+  return AddInPlace(other.digits_.data(), other.digits_.size(), !other.is_negative_);
+}
+BigInteger &BigInteger::operator+=(int64_t other) {
+  Digit digits[2];
+  size_t size = SplitInt64(other, digits);
+  return AddInPlace(digits, size, other < 0);
+}
+BigInteger &BigInteger::operator-=(int64_t other) {
+  Digit digits[2];
+  size_t size = SplitInt64(other, digits);
+  return AddInPlace(digits, size, other >= 0);
+}
+BigInteger &BigInteger::operator*=(int64_t other) {
+  Digit digits[2];
+  size_t size = SplitInt64(other, digits);
+  return MulInPlace(digits, size, other < 0);
+}
+void DivideWithRemainder(const BigInteger& l, const BigInteger& r, BigInteger* quotient, BigInteger* remainder){
+  if (r.digits_.empty()){
+    throw BigIntegerDivisionByZero{};
+  }
+
+  size_t n = l.digits_.size();
+  size_t m = r.digits_.size();
+  std::vector<Digit> quotient_digits;
+  std::vector<Digit> remainder_digits;
+  if (CompareDigits(l.digits_.data(), n, r.digits_.data(), m) < 0){
+    remainder_digits.assign(l.digits_.begin(), l.digits_.end());
+  } else if (m == 1){
+    quotient_digits.resize(n);
+    remainder_digits.push_back(DivModDigit(l.digits_.data(), n, r.digits_[0], quotient_digits.data()));
+  } else if (UseBarrettDivision(n, m)){
+    BarrettDivMod(std::vector<Digit>(l.digits_.begin(), l.digits_.end()),
+                  std::vector<Digit>(r.digits_.begin(), r.digits_.end()), quotient_digits, remainder_digits);
+  } else {
+    quotient_digits.resize(n - m + 1);
+    remainder_digits.resize(m);
+    KnuthDivMod(l.digits_.data(), n, r.digits_.data(), m, quotient_digits.data(), remainder_digits.data());
+  }
+
+  bool quotient_is_negative = l.is_negative_ != r.is_negative_;
+  bool remainder_is_negative = l.is_negative_;
+  if (quotient != nullptr){
+    quotient->digits_.assign(quotient_digits.begin(), quotient_digits.end());
+    quotient->is_negative_ = quotient_is_negative;
+    RemoveLeadingZeros(*quotient);
+  }
+  if (remainder != nullptr){
+    remainder->digits_.assign(remainder_digits.begin(), remainder_digits.end());
+    remainder->is_negative_ = remainder_is_negative;
+    RemoveLeadingZeros(*remainder);
+  }
+}
+BigInteger BigInteger::DivMod(const BigInteger &divisor, BigInteger *remainder) const {
+  BigInteger quotient;
+  DivideWithRemainder(*this, divisor, &quotient, remainder);
+  return quotient;
 }
 BigInteger operator/(const BigInteger &l, const BigInteger &r) {
-  if (r == 0){
+  return l.DivMod(r, nullptr);
+}
+BigInteger &BigInteger::operator/=(const BigInteger &other) {
+  DivideWithRemainder(*this, other, this, nullptr);
+  return *this;
+}
+BigInteger operator%(const BigInteger &l, const BigInteger &r) {
+  BigInteger result;
+  DivideWithRemainder(l, r, nullptr, &result);
+  return result;
+}
+BigInteger &BigInteger::operator%=(const BigInteger &other) {
+  DivideWithRemainder(*this, other, nullptr, this);
+  return *this;
+}
+BigInteger PowMod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus) {
+  if (modulus.digits_.empty()){
     throw BigIntegerDivisionByZero{};
   }
+  if (exponent.is_negative_){
+    throw BigIntegerNegativeExponent{};
+  }
 
   BigInteger result;
-  result.digits_.resize(l.digits_.size());
-  BigInteger abs_right = r;
-  abs_right.is_negative_ = false;
-
-  BigInteger current;
-  for (int i = static_cast<int>(l.digits_.size() - 1); i >= 0; --i) {
-    current.digits_.insert(current.digits_.begin(), l.digits_[i]);
-    int x = 0;
-    int left = 0;
-    int right = BigInteger::digit_mod;
-    while (left <= right) {
-      int m = (left + right) / 2;
-      BigInteger t = abs_right * m;
-      if (t <= current) {
-        x = m;
-        left = m + 1;
-      }
-      else{
-        right = m - 1;
-      }
-    }
+  std::vector<Digit> m(modulus.digits_.begin(), modulus.digits_.end());
+  if (m.size() == 1 && m[0] == 1){
+    return result;
+  }
+  if (exponent.digits_.empty()){
+    return 1;
+  }
+
+  BigInteger reduced;
+  DivideWithRemainder(base, modulus, nullptr, &reduced);
+  if (reduced.is_negative_){
+    reduced.AddInPlace(m.data(), m.size(), false);
+  }
+  std::vector<Digit> value(reduced.digits_.begin(), reduced.digits_.end());
+  value.resize(m.size());
+  if (m[0] % 2 == 1){
+    PowResidue<MontgomeryReducer>(m, value, exponent.digits_.data(), exponent.digits_.size());
+  } else {
+    PowResidue<BarrettReducer>(m, value, exponent.digits_.data(), exponent.digits_.size());
+  }
+  result.digits_.assign(value.begin(), value.end());
+  RemoveLeadingZeros(result);
+  return result;
+}
+BigInteger Gcd(const BigInteger& a, const BigInteger& b) {
+  bool swapped = CompareDigits(a.digits_.data(), a.digits_.size(), b.digits_.data(), b.digits_.size()) < 0;
+  const BigInteger& bigger = swapped ? b : a;
+  const BigInteger& smaller = swapped ? a : b;
+  SignedDigits gcd = MakeSigned(bigger.digits_.data(), bigger.digits_.size());
+  SignedDigits rest = MakeSigned(smaller.digits_.data(), smaller.digits_.size());
+  LehmerGcd(gcd, rest, nullptr);
+
+  BigInteger result;
+  result.digits_.assign(gcd.digits.begin(), gcd.digits.end());
+  return result;
+}
+BigInteger Lcm(const BigInteger& a, const BigInteger& b) {
+  BigInteger gcd = Gcd(a, b);
+  if (gcd == 0){
+    return gcd;
+  }
+  BigInteger result = a / gcd * b;
+  return result.IsNegative() ? -result : result;
+}
+BigInteger ExtendedGcd(const BigInteger& a, const BigInteger& b, BigInteger* x, BigInteger* y) {
+  bool swapped = CompareDigits(a.digits_.data(), a.digits_.size(), b.digits_.data(), b.digits_.size()) < 0;
+  const BigInteger& bigger = swapped ? b : a;
+  const BigInteger& smaller = swapped ? a : b;
+  SignedDigits gcd = MakeSigned(bigger.digits_.data(), bigger.digits_.size());
+  SignedDigits rest = MakeSigned(smaller.digits_.data(), smaller.digits_.size());
+  GcdCofactors cofactors;
+  if (!gcd.digits.empty()){
+    cofactors.current.digits.push_back(1);
+  }
+  LehmerGcd(gcd, rest, &cofactors);
 
-    result.digits_[i] = x;
-    current = current - abs_right * x;
+  // gcd = u * |bigger| + v * |smaller|, so v follows from one exact division.
+  const SignedDigits& u = cofactors.current;
+  SignedDigits v;
+  if (!smaller.digits_.empty()){
+    SignedDigits numerator = AddSigned(gcd, MulSigned(u, MakeSigned(bigger.digits_.data(), bigger.digits_.size())),
+                                       true);
+    std::vector<Digit> divisor(smaller.digits_.begin(), smaller.digits_.end());
+    std::vector<Digit> remainder;
+    DivModMagnitudes(numerator.digits, divisor, v.digits, remainder);
+    v.is_negative = numerator.is_negative;
   }
 
+  auto assign = [](BigInteger* out, const SignedDigits& value, bool negate) {
+    if (out != nullptr){
+      out->digits_.assign(value.digits.begin(), value.digits.end());
+      out->is_negative_ = value.is_negative != negate;
+      RemoveLeadingZeros(*out);
+    }
+  };
+  assign(swapped ? y : x, u, bigger.is_negative_);
+  assign(swapped ? x : y, v, smaller.is_negative_);
+  BigInteger result;
+  result.digits_.assign(gcd.digits.begin(), gcd.digits.end());
+  return result;
+}
+BigInteger IRoot(const BigInteger& value, uint32_t k) {
+  if (k == 0 || (value.is_negative_ && k % 2 == 0)){
+    throw BigIntegerInvalidRoot{};
+  }
+  BigInteger result;
+  if (k == 1){
+    result = value;
+    return result;
+  }
+  std::vector<Digit> root = RootMagnitude(std::vector<Digit>(value.digits_.begin(), value.digits_.end()), k);
+  result.digits_.assign(root.begin(), root.end());
+  result.is_negative_ = value.is_negative_;
   RemoveLeadingZeros(result);
-  result.is_negative_ = l.is_negative_ != r.is_negative_ && result != 0;
   return result;
 }
-BigInteger &BigInteger::operator/=(const BigInteger &other) {
-  *this = *this / other;
-  return *this;
+BigInteger ISqrt(const BigInteger& value) {
+  return IRoot(value, 2);
 }
-BigInteger operator%(const BigInteger &l, const BigInteger &r) {
+template <class Operation>
+BigInteger BigInteger::Bitwise(const BigInteger& l, const BigInteger& r, Operation operation) {
+  size_t size = std::max(l.digits_.size(), r.digits_.size());
+  Digit l_sign = l.is_negative_ ? ~Digit{0} : 0;
+  Digit r_sign = r.is_negative_ ? ~Digit{0} : 0;
+  bool is_negative = operation(l_sign, r_sign) != 0;
+
+  // Both operands and a negative result are converted to and from two's complement in the same pass.
   BigInteger result;
-  BigInteger abs_l = l;
-  abs_l.is_negative_ = false;
-  BigInteger abs_r = r;
-  abs_r.is_negative_ = false;
-  result = abs_l - abs_r * (abs_l/abs_r);
-  result.is_negative_ = l.is_negative_;
+  result.digits_.resize(size);
+  Digit l_borrow = 1;
+  Digit r_borrow = 1;
+  Digit carry = 1;
+  for (size_t i = 0; i < size; ++i) {
+    Digit a = TwosComplementDigit(i < l.digits_.size() ? l.digits_[i] : 0, l.is_negative_, l_borrow);
+    Digit b = TwosComplementDigit(i < r.digits_.size() ? r.digits_[i] : 0, r.is_negative_, r_borrow);
+    Digit digit = operation(a, b);
+    if (is_negative){
+      digit = ~digit + carry;
+      carry &= digit == 0;
+    }
+    result.digits_[i] = digit;
+  }
+  if (is_negative && carry != 0){
+    result.digits_.push_back(1);
+  }
+  result.is_negative_ = is_negative;
+  RemoveLeadingZeros(result);
   return result;
 }
-BigInteger &BigInteger::operator%=(const BigInteger &other) {
-  *this = *this % other;
+BigInteger operator&(const BigInteger &l, const BigInteger &r) {
+  return BigInteger::Bitwise(l, r, [](Digit a, Digit b) { return a & b; });
+}
+BigInteger operator|(const BigInteger &l, const BigInteger &r) {
+  return BigInteger::Bitwise(l, r, [](Digit a, Digit b) { return a | b; });
+}
+BigInteger operator^(const BigInteger &l, const BigInteger &r) {
+  return BigInteger::Bitwise(l, r, [](Digit a, Digit b) { return a ^ b; });
+}
+BigInteger BigInteger::operator~() const {
+  BigInteger result = -*this;
+  --result;
+  return result;
+}
+BigInteger &BigInteger::operator&=(const BigInteger &other) {
+  *this = *this & other;
+  return *this;
+}
+BigInteger &BigInteger::operator|=(const BigInteger &other) {
+  *this = *this | other;
+  return *this;
+}
+BigInteger &BigInteger::operator^=(const BigInteger &other) {
+  *this = *this ^ other;
+  return *this;
+}
+BigInteger &BigInteger::operator<<=(size_t shift) {
+  if (digits_.empty() || shift == 0){
+    return *this;
+  }
+  size_t bits = (digits_.size() - 1) * BigInteger::digit_bits + CountBits(digits_.back());
+  // Checked up front so that an absurd shift throws instead of allocating.
+  if ((static_cast<double>(bits - 1) + static_cast<double>(shift)) * kLog10Of2 >= BigInteger::digit_max_size){
+    throw BigIntegerOverflow{};
+  }
+
+  size_t limbs = shift / BigInteger::digit_bits;
+  size_t size = digits_.size();
+  Digit carry = ShiftLeftDigits(digits_.data(), digits_.data(), size, shift % BigInteger::digit_bits);
+  digits_.resize(size + limbs + 1);
+  digits_[size] = carry;
+  std::copy_backward(digits_.begin(), digits_.begin() + size + 1, digits_.end());
+  std::fill(digits_.begin(), digits_.begin() + limbs, 0);
+  RemoveLeadingZeros(*this);
+  return *this;
+}
+BigInteger &BigInteger::operator>>=(size_t shift) {
+  if (digits_.empty() || shift == 0){
+    return *this;
+  }
+  // Rounding toward negative infinity: -x >> k == -(((x - 1) >> k) + 1).
+  if (is_negative_){
+    DecrementDigits(digits_);
+  }
+  size_t limbs = shift / BigInteger::digit_bits;
+  if (limbs >= digits_.size()){
+    digits_.clear();
+  } else {
+    size_t size = digits_.size() - limbs;
+    ShiftRightDigits(digits_.data(), digits_.data() + limbs, size, shift % BigInteger::digit_bits);
+    digits_.resize(size);
+  }
+  while (!digits_.empty() && digits_.back() == 0){
+    digits_.pop_back();
+  }
+  if (is_negative_){
+    IncrementDigits(digits_);
+  }
+  return *this;
+}
+BigInteger operator<<(const BigInteger &l, size_t shift) {
+  BigInteger result = l;
+  result <<= shift;
+  return result;
+}
+BigInteger operator>>(const BigInteger &l, size_t shift) {
+  BigInteger result = l;
+  result >>= shift;
+  return result;
+}
+size_t BigInteger::PopCount() const {
+  return PopCountDigits(digits_.data(), digits_.size());
+}
+BigInteger &BigInteger::AssignTerms(const BigIntegerTerm *terms, size_t count) {
+  size_t capacity = 0;
+  for (size_t i = 0; i < count; ++i) {
+    size_t size = 0;
+    for (size_t j = 0; j < terms[i].size; ++j) {
+      if (terms[i].factors[j] == this){
+        BigInteger result;
+        result.AssignTerms(terms, count);
+        return *this = std::move(result);
+      }
+      size += terms[i].factors[j]->digits_.size();
+    }
+    capacity = std::max(capacity, size);
+  }
+  digits_.clear();
+  is_negative_ = false;
+  digits_.reserve(capacity + 1);
+
+  // Each product alternates between two scratch buffers, and a single factor is added straight from its
+  // own limbs.
+  static thread_local LimbBuffer scratch[2];
+  for (size_t i = 0; i < count; ++i) {
+    const BigInteger& first = *terms[i].factors[0];
+    const Digit* product = first.digits_.data();
+    size_t size = first.digits_.size();
+    bool is_negative = first.is_negative_ != terms[i].negate;
+    for (size_t j = 1; j < terms[i].size && size != 0; ++j) {
+      const BigInteger& factor = *terms[i].factors[j];
+      LimbBuffer& out = scratch[j % 2];
+      size_t factor_size = factor.digits_.size();
+      if (factor_size == 0){
+        size = 0;
+        break;
+      }
+      out.resize(size + factor_size);
+      if (size >= factor_size){
+        MulDigits(product, size, factor.digits_.data(), factor_size, out.data());
+      } else {
+        MulDigits(factor.digits_.data(), factor_size, product, size, out.data());
+      }
+      size += factor_size;
+      while (size != 0 && out[size - 1] == 0) {
+        --size;
+      }
+      product = out.data();
+      is_negative = is_negative != factor.is_negative_;
+    }
+    if (size != 0){
+      AddInPlace(product, size, is_negative);
+    }
+  }
   return *this;
 }
+size_t BigInteger::SerializedSize() const {
+  return VarintSize(digits_.size() << 1) + digits_.size() * kLimbBytes;
+}
+size_t BigInteger::Serialize(unsigned char *out) const {
+  unsigned char* begin = out;
+  size_t header = digits_.size() << 1 | (is_negative_ ? 1 : 0);
+  for (; header >= 0x80; header >>= 7) {
+    *out++ = static_cast<unsigned char>(header | 0x80);
+  }
+  *out++ = static_cast<unsigned char>(header);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  std::memcpy(out, digits_.data(), digits_.size() * kLimbBytes);
+  out += digits_.size() * kLimbBytes;
+#else
+  for (Digit digit : digits_) {
+    for (size_t i = 0; i < kLimbBytes; ++i) {
+      *out++ = static_cast<unsigned char>(digit >> (8 * i));
+    }
+  }
+#endif
+  return static_cast<size_t>(out - begin);
+}
+BigInteger BigInteger::Deserialize(const unsigned char *data, size_t size, size_t *consumed) {
+  size_t header = 0;
+  size_t position = 0;
+  for (size_t shift = 0;; shift += 7) {
+    if (position == size || shift >= 8 * sizeof(size_t)){
+      throw BigIntegerInvalidFormat{};
+    }
+    unsigned char byte = data[position++];
+    size_t bits = byte & 0x7F;
+    // Only the shortest encoding is accepted: a zero final byte would be padding, and bits shifted out
+    // of size_t would need a longer varint than any valid header.
+    if ((shift != 0 && byte == 0) || (bits << shift) >> shift != bits){
+      throw BigIntegerInvalidFormat{};
+    }
+    header |= bits << shift;
+    if ((byte & 0x80) == 0){
+      break;
+    }
+  }
+
+  size_t limbs = header >> 1;
+  bool is_negative = (header & 1) != 0;
+  if (limbs > (size - position) / kLimbBytes || (limbs == 0 && is_negative)){
+    throw BigIntegerInvalidFormat{};
+  }
+  BigInteger result;
+  result.digits_.resize(limbs);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  std::memcpy(result.digits_.data(), data + position, limbs * kLimbBytes);
+  position += limbs * kLimbBytes;
+#else
+  for (Digit& digit : result.digits_) {
+    digit = 0;
+    for (size_t i = 0; i < kLimbBytes; ++i) {
+      digit |= static_cast<Digit>(data[position++]) << (8 * i);
+    }
+  }
+#endif
+  if (limbs != 0 && result.digits_.back() == 0){
+    throw BigIntegerInvalidFormat{};
+  }
+  result.is_negative_ = is_negative;
+  CheckOverflow(result);
+  if (consumed != nullptr){
+    *consumed = position;
+  }
+  return result;
+}
+void AddMany(const BigInteger* l, const BigInteger* r, BigInteger* out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const BigInteger& addend = &out[i] == &r[i] ? l[i] : r[i];
+    if (&out[i] != &l[i] && &out[i] != &r[i]){
+      out[i].digits_.assign(l[i].digits_.begin(), l[i].digits_.end());
+      out[i].is_negative_ = l[i].is_negative_;
+    }
+    out[i].AddInPlace(addend.digits_.data(), addend.digits_.size(), addend.is_negative_);
+  }
+}
+void MulMany(const BigInteger* l, const BigInteger* r, BigInteger* out, size_t count) {
+  auto multiply = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const BigInteger& factor = &out[i] == &r[i] ? l[i] : r[i];
+      if (&out[i] == &l[i] || &out[i] == &r[i]){
+        out[i].MulInPlace(factor.digits_.data(), factor.digits_.size(), factor.is_negative_);
+        continue;
+      }
+      const LimbBuffer& a = l[i].digits_.size() >= r[i].digits_.size() ? l[i].digits_ : r[i].digits_;
+      const LimbBuffer& b = l[i].digits_.size() >= r[i].digits_.size() ? r[i].digits_ : l[i].digits_;
+      out[i].digits_.clear();
+      out[i].is_negative_ = false;
+      if (b.empty()){
+        continue;
+      }
+      out[i].digits_.resize(a.size() + b.size());
+      MulDigits(a.data(), a.size(), b.data(), b.size(), out[i].digits_.data());
+      out[i].is_negative_ = l[i].is_negative_ != r[i].is_negative_;
+      RemoveLeadingZeros(out[i]);
+      CheckOverflow(out[i]);
+    }
+  };
+
+  // The batch is cut into one chunk per allowed thread; chunks below the grain size run on the caller.
+  size_t chunks = std::max<size_t>(1, std::min(BigInteger::max_threads, count));
+  std::vector<std::future<void>> tasks;
+  for (size_t chunk = 0; chunk + 1 < chunks; ++chunk) {
+    size_t begin = count * chunk / chunks;
+    size_t end = count * (chunk + 1) / chunks;
+    size_t limbs = 0;
+    for (size_t i = begin; i < end; ++i) {
+      limbs += l[i].digits_.size() + r[i].digits_.size();
+    }
+    tasks.push_back(Fork(limbs, [&multiply, begin, end] {
+      multiply(begin, end);
+    }));
+  }
+  multiply(count * (chunks - 1) / chunks, count);
+  for (auto& task : tasks) {
+    Join(task);
+  }
+}
+BigInteger SumReduce(const BigInteger* values, size_t count) {
+  size_t capacity = 0;
+  for (size_t i = 0; i < count; ++i) {
+    capacity = std::max(capacity, values[i].digits_.size());
+  }
+  // Same-sign sums never cancel, so both accumulators only grow and one final subtraction settles the sign.
+  BigInteger sums[2];
+  for (BigInteger& sum : sums) {
+    sum.digits_.reserve(capacity + 1);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const BigInteger& value = values[i];
+    sums[value.is_negative_].AddInPlace(value.digits_.data(), value.digits_.size(), false);
+  }
+  sums[0].AddInPlace(sums[1].digits_.data(), sums[1].digits_.size(), true);
+  return std::move(sums[0]);
+}
+BigInteger ProductTree(const BigInteger* values, size_t count) {
+  if (count <= 1){
+    return count == 0 ? BigInteger(1) : values[0];
+  }
+  if (count == 2){
+    return values[0] * values[1];
+  }
+  size_t half = count / 2;
+  size_t limbs = 0;
+  for (size_t i = 0; i < half; ++i) {
+    limbs += values[i].digits_.size();
+  }
+  BigInteger low;
+  std::future<void> low_task = Fork(limbs, [&] {
+    low = ProductTree(values, half);
+  });
+  BigInteger high = ProductTree(values + half, count - half);
+  Join(low_task);
+  return low * high;
+}
+BigInteger Factorial(uint32_t n) {
+  // The odd parts of 2..n are packed into single limbs and multiplied by a tree; the powers of two are
+  // restored by one shift at the end.
+  std::vector<BigInteger> factors;
+  DoubleDigit packed = 1;
+  size_t twos = 0;
+  for (uint32_t i = 2; i <= n && i != 0; ++i) {
+    uint32_t odd = i;
+    for (; odd % 2 == 0; odd /= 2) {
+      ++twos;
+    }
+    PackFactor(odd, packed, factors);
+  }
+  return PackedProduct(packed, factors) << twos;
+}
+BigInteger Binomial(uint32_t n, uint32_t k) {
+  if (k > n){
+    return 0;
+  }
+  k = std::min(k, n - k);
+  std::vector<BigInteger> factors;
+  DoubleDigit packed = 1;
+  if (n / kBinomialSieveRatio > k){
+    // n (n - 1) ... (n - k + 1) / k!, with both products formed by a tree and one exact division.
+    for (uint32_t i = n - k + 1; i <= n && i != 0; ++i) {
+      PackFactor(i, packed, factors);
+    }
+    return PackedProduct(packed, factors) / Factorial(k);
+  }
+  // By Kummer's theorem the exponent of a prime p in C(n, k) is the number of borrows when subtracting
+  // k from n in base p, so only primes up to n are visited and no division is needed.
+  std::vector<bool> composite(static_cast<size_t>(n) + 1);
+  for (DoubleDigit p = 2; p <= n && k != 0; ++p) {
+    if (composite[p]){
+      continue;
+    }
+    for (DoubleDigit multiple = p * p; multiple <= n; multiple += p) {
+      composite[multiple] = true;
+    }
+    for (DoubleDigit power = p; power <= n; power *= p) {
+      if (n / power - k / power - (n - k) / power != 0){
+        PackFactor(static_cast<Digit>(p), packed, factors);
+      }
+    }
+  }
+  return PackedProduct(packed, factors);
+}
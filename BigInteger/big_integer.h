@@ -2,11 +2,12 @@
 #define BIGINTEGER__BIG_INTEGER_H_
 #define BIG_INTEGER_DIVISION_IMPLEMENTED
 
-#include <cmath>
 #include <cstdint>
 #include <vector>
 #include <stdexcept>
 
+#include "limb_buffer.h"
+
 class BigIntegerOverflow : public std::runtime_error {
  public:
   BigIntegerOverflow() : std::runtime_error("BigIntegerOverflow") {
@@ -19,32 +20,95 @@ class BigIntegerDivisionByZero : public std::runtime_error {
   }
 };
 
+class BigIntegerNegativeExponent : public std::runtime_error {
+ public:
+  BigIntegerNegativeExponent() : std::runtime_error("BigIntegerNegativeExponent") {
+  }
+};
+
+class BigIntegerInvalidFormat : public std::runtime_error {
+ public:
+  BigIntegerInvalidFormat() : std::runtime_error("BigIntegerInvalidFormat") {
+  }
+};
+
+class BigIntegerInvalidRoot : public std::runtime_error {
+ public:
+  BigIntegerInvalidRoot() : std::runtime_error("BigIntegerInvalidRoot") {
+  }
+};
+
+class BigInteger;
+
+// One signed product of a sum evaluated in a single pass; built by the expression layer in
+// big_integer_expr.h.
+struct BigIntegerTerm {
+  const BigInteger* const* factors;
+  size_t size;
+  bool negate;
+};
+
 class BigInteger{
   friend BigInteger operator+(const BigInteger& l, const BigInteger& r);
   friend BigInteger operator-(const BigInteger& l, const BigInteger& r);
   friend BigInteger operator*(const BigInteger& l, const BigInteger& r);
   friend BigInteger operator/(const BigInteger& l, const BigInteger& r);
   friend BigInteger operator%(const BigInteger& l, const BigInteger& r);
+  friend BigInteger operator&(const BigInteger& l, const BigInteger& r);
+  friend BigInteger operator|(const BigInteger& l, const BigInteger& r);
+  friend BigInteger operator^(const BigInteger& l, const BigInteger& r);
+  friend BigInteger operator<<(const BigInteger& l, size_t shift);
+  friend BigInteger operator>>(const BigInteger& l, size_t shift);
   friend bool operator<(const BigInteger& l, const BigInteger& r);
   friend bool operator<=(const BigInteger& l, const BigInteger& r);
   friend bool operator>(const BigInteger& l, const BigInteger& r);
   friend bool operator>=(const BigInteger& l, const BigInteger& r);
   friend bool operator==(const BigInteger& l, const BigInteger& r);
   friend bool operator!=(const BigInteger& l, const BigInteger& r);
+  friend bool operator<(const BigInteger& l, int64_t r);
+  friend bool operator<=(const BigInteger& l, int64_t r);
+  friend bool operator>(const BigInteger& l, int64_t r);
+  friend bool operator>=(const BigInteger& l, int64_t r);
+  friend bool operator==(const BigInteger& l, int64_t r);
+  friend bool operator!=(const BigInteger& l, int64_t r);
+  friend int CompareWithInt64(const BigInteger& l, int64_t r);
   friend std::ostream& operator<<(std::ostream& ostream, const BigInteger& other);
   friend std::istream& operator>>(std::istream& istream, BigInteger& other);
   friend void RemoveLeadingZeros(BigInteger& number);
+  friend void CheckOverflow(const BigInteger& number);
+  friend void DivideWithRemainder(const BigInteger& l, const BigInteger& r, BigInteger* quotient,
+                                  BigInteger* remainder);
+  friend BigInteger PowMod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus);
+  friend BigInteger Gcd(const BigInteger& a, const BigInteger& b);
+  friend BigInteger ExtendedGcd(const BigInteger& a, const BigInteger& b, BigInteger* x, BigInteger* y);
+  friend BigInteger IRoot(const BigInteger& value, uint32_t k);
+  friend void AddMany(const BigInteger* l, const BigInteger* r, BigInteger* out, size_t count);
+  friend void MulMany(const BigInteger* l, const BigInteger* r, BigInteger* out, size_t count);
+  friend BigInteger SumReduce(const BigInteger* values, size_t count);
+  friend BigInteger ProductTree(const BigInteger* values, size_t count);
+  friend struct BigIntegerExprAccess;
+  template <size_t Limbs>
+  friend class StaticBigInteger;
+  template <size_t Bits, bool Signed>
+  friend class WideInt;
 
  public:
   using DigitType = u_int32_t;
-  inline static u_int16_t digit_size = 3;
-  inline static u_int16_t digit_max_size = 30001;
-  inline static u_int16_t digit_mod = static_cast<uint16_t>(std::pow(10, digit_size));
+  using DoubleDigitType = u_int64_t;
+  inline static const u_int16_t digit_bits = 32;
+  inline static size_t digit_max_size = 30001;
+  // Multiplications and decimal conversions whose operands reach parallel_grain_limbs limbs split their
+  // recursion across up to max_threads threads in total; the default of 1 keeps all work on the caller.
+  inline static size_t max_threads = 1;
+  inline static size_t parallel_grain_limbs = 8192;
   BigInteger() = default;
   BigInteger(int32_t num); // NOLINT
   BigInteger(int64_t num); // NOLINT
   BigInteger(const char* char_arr); // NOLINT
   [[nodiscard]] bool IsNegative() const;
+  // Truncated division: returns *this / divisor and stores *this % divisor (sign of *this) into
+  // remainder unless it is null, both from a single pass.
+  BigInteger DivMod(const BigInteger& divisor, BigInteger* remainder) const;
 
   BigInteger operator+() const;
   BigInteger operator-() const;
@@ -57,10 +121,74 @@ class BigInteger{
   BigInteger& operator-=(const BigInteger& other);
   BigInteger& operator/=(const BigInteger& other);
   BigInteger& operator%=(const BigInteger& other);
+  BigInteger& operator+=(int64_t other);
+  BigInteger& operator-=(int64_t other);
+  BigInteger& operator*=(int64_t other);
+
+  // Bitwise operators act on the infinite two's complement form, so -1 has every bit set and >> rounds
+  // toward negative infinity.
+  BigInteger operator~() const;
+  BigInteger& operator&=(const BigInteger& other);
+  BigInteger& operator|=(const BigInteger& other);
+  BigInteger& operator^=(const BigInteger& other);
+  BigInteger& operator<<=(size_t shift);
+  BigInteger& operator>>=(size_t shift);
+  // Number of set bits in the magnitude.
+  [[nodiscard]] size_t PopCount() const;
+
+  // Binary format: a LEB128 varint of (limb count << 1 | sign) followed by the limbs as little-endian
+  // 32-bit words, lowest first. Zero is the single byte 0.
+  [[nodiscard]] size_t SerializedSize() const;
+  // Writes SerializedSize() bytes to out and returns that count.
+  size_t Serialize(unsigned char* out) const;
+  // Reads one value from the start of data; stores the number of bytes used into consumed unless it is
+  // null, so that consecutive values can be read back in sequence. Truncated or non-canonical input
+  // throws BigIntegerInvalidFormat.
+  static BigInteger Deserialize(const unsigned char* data, size_t size, size_t* consumed = nullptr);
 
 
  private:
-  std::vector<DigitType> digits_;
+  // l + r or l - r in one pass over the limbs: magnitudes are compared and subtracted in place on the
+  // operands' spans, so mixed signs cost no copies beyond the result.
+  static BigInteger Sum(const BigInteger& l, const BigInteger& r, bool subtract);
+  // Adds a signed limb span into the existing limb buffer, growing it only when the result needs to.
+  BigInteger& AddInPlace(const DigitType* digits, size_t size, bool is_negative);
+  BigInteger& MulInPlace(const DigitType* digits, size_t size, bool is_negative);
+  // *this = the sum of the terms, with each product formed in per-thread scratch limbs.
+  BigInteger& AssignTerms(const BigIntegerTerm* terms, size_t count);
+  template <class Operation>
+  static BigInteger Bitwise(const BigInteger& l, const BigInteger& r, Operation operation);
+
+  // Little-endian limbs in base 2^digit_bits, empty for zero; values up to 128 bits are stored inline.
+  LimbBuffer digits_;
   bool is_negative_ = false;
 };
+
+// base^exponent mod |modulus| in [0, |modulus|) for a non-negative exponent. Odd moduli use Montgomery
+// multiplication, even ones Barrett reduction, both with sliding-window exponentiation.
+BigInteger PowMod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus);
+// Non-negative gcd and lcm by Lehmer's algorithm with a binary GCD tail; Gcd(0, 0) and Lcm(x, 0) are 0.
+BigInteger Gcd(const BigInteger& a, const BigInteger& b);
+BigInteger Lcm(const BigInteger& a, const BigInteger& b);
+// Returns Gcd(a, b) and stores Bezout coefficients with a * x + b * y == Gcd(a, b) into the non-null
+// outputs.
+BigInteger ExtendedGcd(const BigInteger& a, const BigInteger& b, BigInteger* x, BigInteger* y);
+// The k-th root truncated toward zero, by Newton's method with precision doubling. Negative values only
+// have odd roots; k == 0 or an even root of a negative value throws BigIntegerInvalidRoot.
+BigInteger IRoot(const BigInteger& value, uint32_t k);
+BigInteger ISqrt(const BigInteger& value);
+// Element-wise out[i] = l[i] + r[i] and out[i] = l[i] * r[i] for i < count; out may be l or r. Results are
+// written into the limb buffers out already holds, so reusing the same outputs across batches stops
+// allocating, and large multiplication batches are split across BigInteger::max_threads.
+void AddMany(const BigInteger* l, const BigInteger* r, BigInteger* out, size_t count);
+void MulMany(const BigInteger* l, const BigInteger* r, BigInteger* out, size_t count);
+// Sum of values[0, count), accumulating positive and negative terms in place separately.
+BigInteger SumReduce(const BigInteger* values, size_t count);
+// Product of values[0, count) by a balanced tree, so large products are formed from operands of similar
+// size; the empty product is 1.
+BigInteger ProductTree(const BigInteger* values, size_t count);
+// n! and the binomial coefficient C(n, k), which is 0 for k > n; both multiply packed factors by a
+// product tree. Binomial sieves primes up to n only when min(k, n - k) is a sizable fraction of n.
+BigInteger Factorial(uint32_t n);
+BigInteger Binomial(uint32_t n, uint32_t k);
 #endif //BIGINTEGER__BIG_INTEGER_H_
@@ -0,0 +1,149 @@
+// Throughput of BigInteger arithmetic and conversions across operand sizes. Every result is one line of
+// CSV (default) or one element of a JSON array on stdout, so runs can be diffed between revisions.
+//
+//   BigIntegerBenchmark [--format csv|json] [--max-digits N] [--min-time-ms T] [--threads K]
+
+#include "big_integer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+  bool json = false;
+  size_t max_digits = 100000;
+  double min_time_ms = 200;
+};
+
+struct Result {
+  std::string operation;
+  size_t digits;
+  size_t limbs;
+  size_t iterations;
+  double ns_per_op;
+};
+
+volatile size_t sink = 0;
+
+std::string RandomDigits(size_t digits, std::mt19937_64& generator) {
+  std::uniform_int_distribution<int> digit(0, 9);
+  std::string result(digits, '0');
+  for (char& c : result) {
+    c = static_cast<char>('0' + digit(generator));
+  }
+  result[0] = static_cast<char>('1' + digit(generator) % 9);
+  return result;
+}
+
+// Limbs of a value with the given number of decimal digits.
+size_t LimbsForDigits(size_t digits) {
+  return static_cast<size_t>(static_cast<double>(digits) * 3.32192809488736234787 / BigInteger::digit_bits) + 1;
+}
+
+// Runs operation in batches that double until one takes at least min_time_ms.
+Result Measure(const std::string& operation, size_t digits, const Options& options,
+               const std::function<void()>& body) {
+  using Clock = std::chrono::steady_clock;
+  body();
+  for (size_t iterations = 1;; iterations *= 2) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      body();
+    }
+    double elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (elapsed_ns >= options.min_time_ms * 1e6) {
+      return {operation, digits, LimbsForDigits(digits), iterations, elapsed_ns / static_cast<double>(iterations)};
+    }
+  }
+}
+
+void Print(const Result& result, const Options& options, bool first) {
+  double limbs_per_second = static_cast<double>(result.limbs) / result.ns_per_op * 1e9;
+  if (options.json) {
+    std::cout << (first ? "[\n" : ",\n") << "  {\"operation\": \"" << result.operation
+              << "\", \"digits\": " << result.digits << ", \"limbs\": " << result.limbs
+              << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.ns_per_op
+              << ", \"limbs_per_second\": " << limbs_per_second << "}";
+  } else {
+    if (first) {
+      std::cout << "operation,digits,limbs,iterations,ns_per_op,limbs_per_second\n";
+    }
+    std::cout << result.operation << ',' << result.digits << ',' << result.limbs << ',' << result.iterations << ','
+              << result.ns_per_op << ',' << limbs_per_second << '\n';
+  }
+  std::cout.flush();
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (std::strcmp(argv[i], "--format") == 0 && value != nullptr) {
+      options.json = std::strcmp(value, "json") == 0;
+      if (!options.json && std::strcmp(value, "csv") != 0) {
+        return false;
+      }
+    } else if (std::strcmp(argv[i], "--max-digits") == 0 && value != nullptr) {
+      options.max_digits = std::strtoull(value, nullptr, 10);
+    } else if (std::strcmp(argv[i], "--min-time-ms") == 0 && value != nullptr) {
+      options.min_time_ms = std::strtod(value, nullptr);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && value != nullptr) {
+      BigInteger::max_threads = std::strtoull(value, nullptr, 10);
+    } else {
+      return false;
+    }
+    ++i;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::cerr << "usage: " << argv[0] << " [--format csv|json] [--max-digits N] [--min-time-ms T] [--threads K]\n";
+    return 1;
+  }
+  // Operands of size digits; division and remainder take a 2 * digits dividend so the quotient is as
+  // long as the divisor.
+  BigInteger::digit_max_size = std::max(BigInteger::digit_max_size, 2 * options.max_digits + 1);
+  std::mt19937_64 generator(20240611);
+  bool first = true;
+  for (size_t digits = 1; digits <= options.max_digits; digits *= 10) {
+    std::string l_text = RandomDigits(digits, generator);
+    std::string r_text = RandomDigits(digits, generator);
+    BigInteger l(l_text.c_str());
+    BigInteger r(r_text.c_str());
+    BigInteger dividend(RandomDigits(2 * digits, generator).c_str());
+    std::vector<Result> results = {
+        Measure("add", digits, options, [&] { sink = sink + (l + r).IsNegative(); }),
+        Measure("sub", digits, options, [&] { sink = sink + (l - r).IsNegative(); }),
+        Measure("mul", digits, options, [&] { sink = sink + (l * r).IsNegative(); }),
+        Measure("div", digits, options, [&] { sink = sink + (dividend / r).IsNegative(); }),
+        Measure("mod", digits, options, [&] { sink = sink + (dividend % r).IsNegative(); }),
+        Measure("parse", digits, options, [&] { sink = sink + BigInteger(l_text.c_str()).IsNegative(); }),
+        Measure("print", digits, options, [&] {
+          std::ostringstream stream;
+          stream << l;
+          sink = sink + stream.str().size();
+        }),
+    };
+    for (const Result& result : results) {
+      Print(result, options, first);
+      first = false;
+    }
+  }
+  if (options.json) {
+    std::cout << (first ? "[]\n" : "\n]\n");
+  }
+  return 0;
+}
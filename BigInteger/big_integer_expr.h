@@ -0,0 +1,158 @@
+#ifndef BIGINTEGER__BIG_INTEGER_EXPR_H_
+#define BIGINTEGER__BIG_INTEGER_EXPR_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "big_integer.h"
+
+// Opt-in lazy arithmetic for sums of products. Lazy(a) * b + Lazy(c) * d - e builds a small expression
+// object instead of BigInteger temporaries; assigning it evaluates every product in reused per-thread
+// scratch limbs and accumulates the terms into the destination, whose storage is reserved once for the
+// largest possible result. Expressions hold references to their operands, so evaluate them within the
+// statement that builds them.
+
+// Collects the terms of an expression into fixed-size arrays sized at compile time.
+struct BigIntegerTermCollector {
+  BigIntegerTerm* term;
+  const BigInteger** factor;
+};
+
+template <class Derived>
+struct BigIntegerExpr {
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  operator BigInteger() const;
+};
+
+template <size_t Factors>
+struct BigIntegerProduct : BigIntegerExpr<BigIntegerProduct<Factors>> {
+  static const size_t term_count = 1;
+  static const size_t factor_count = Factors;
+
+  void Collect(BigIntegerTermCollector& collector, bool negate) const {
+    *collector.term++ = {collector.factor, Factors, negate};
+    for (const BigInteger* factor : factors) {
+      *collector.factor++ = factor;
+    }
+  }
+
+  std::array<const BigInteger*, Factors> factors;
+};
+
+template <class L, class R, bool Subtract>
+struct BigIntegerSum : BigIntegerExpr<BigIntegerSum<L, R, Subtract>> {
+  static const size_t term_count = L::term_count + R::term_count;
+  static const size_t factor_count = L::factor_count + R::factor_count;
+
+  BigIntegerSum(const L& l, const R& r) : l(l), r(r) {
+  }
+
+  void Collect(BigIntegerTermCollector& collector, bool negate) const {
+    l.Collect(collector, negate);
+    r.Collect(collector, negate != Subtract);
+  }
+
+  L l;
+  R r;
+};
+
+template <class E>
+struct BigIntegerNegation : BigIntegerExpr<BigIntegerNegation<E>> {
+  static const size_t term_count = E::term_count;
+  static const size_t factor_count = E::factor_count;
+
+  explicit BigIntegerNegation(const E& e) : e(e) {
+  }
+
+  void Collect(BigIntegerTermCollector& collector, bool negate) const {
+    e.Collect(collector, !negate);
+  }
+
+  E e;
+};
+
+struct BigIntegerExprAccess {
+  static BigInteger& Assign(BigInteger& out, const BigIntegerTerm* terms, size_t count) {
+    return out.AssignTerms(terms, count);
+  }
+};
+
+inline BigIntegerProduct<1> Lazy(const BigInteger& value) {
+  BigIntegerProduct<1> product;
+  product.factors[0] = &value;
+  return product;
+}
+
+// Evaluates expr into out, reusing out's storage; out may appear in expr.
+template <class Derived>
+BigInteger& Assign(BigInteger& out, const BigIntegerExpr<Derived>& expr) {
+  const auto& derived = static_cast<const Derived&>(expr);
+  std::array<BigIntegerTerm, Derived::term_count> terms;
+  std::array<const BigInteger*, Derived::factor_count> factors;
+  BigIntegerTermCollector collector{terms.data(), factors.data()};
+  derived.Collect(collector, false);
+  return BigIntegerExprAccess::Assign(out, terms.data(), terms.size());
+}
+
+template <class Derived>
+BigIntegerExpr<Derived>::operator BigInteger() const {
+  BigInteger result;
+  Assign(result, *this);
+  return result;
+}
+
+template <size_t N, size_t M>
+BigIntegerProduct<N + M> operator*(const BigIntegerProduct<N>& l, const BigIntegerProduct<M>& r) {
+  BigIntegerProduct<N + M> product;
+  std::copy(l.factors.begin(), l.factors.end(), product.factors.begin());
+  std::copy(r.factors.begin(), r.factors.end(), product.factors.begin() + N);
+  return product;
+}
+
+template <size_t N>
+BigIntegerProduct<N + 1> operator*(const BigIntegerProduct<N>& l, const BigInteger& r) {
+  return l * Lazy(r);
+}
+
+template <size_t N>
+BigIntegerProduct<N + 1> operator*(const BigInteger& l, const BigIntegerProduct<N>& r) {
+  return Lazy(l) * r;
+}
+
+template <class L, class R>
+BigIntegerSum<L, R, false> operator+(const BigIntegerExpr<L>& l, const BigIntegerExpr<R>& r) {
+  return {static_cast<const L&>(l), static_cast<const R&>(r)};
+}
+
+template <class L>
+BigIntegerSum<L, BigIntegerProduct<1>, false> operator+(const BigIntegerExpr<L>& l, const BigInteger& r) {
+  return {static_cast<const L&>(l), Lazy(r)};
+}
+
+template <class R>
+BigIntegerSum<BigIntegerProduct<1>, R, false> operator+(const BigInteger& l, const BigIntegerExpr<R>& r) {
+  return {Lazy(l), static_cast<const R&>(r)};
+}
+
+template <class L, class R>
+BigIntegerSum<L, R, true> operator-(const BigIntegerExpr<L>& l, const BigIntegerExpr<R>& r) {
+  return {static_cast<const L&>(l), static_cast<const R&>(r)};
+}
+
+template <class L>
+BigIntegerSum<L, BigIntegerProduct<1>, true> operator-(const BigIntegerExpr<L>& l, const BigInteger& r) {
+  return {static_cast<const L&>(l), Lazy(r)};
+}
+
+template <class R>
+BigIntegerSum<BigIntegerProduct<1>, R, true> operator-(const BigInteger& l, const BigIntegerExpr<R>& r) {
+  return {Lazy(l), static_cast<const R&>(r)};
+}
+
+template <class E>
+BigIntegerNegation<E> operator-(const BigIntegerExpr<E>& e) {
+  return BigIntegerNegation<E>(static_cast<const E&>(e));
+}
+
+#endif //BIGINTEGER__BIG_INTEGER_EXPR_H_
@@ -2,9 +2,13 @@
 #include "catch.hpp"
 
 #include <iostream>
+#include <type_traits>
 
 #include "big_integer.h"
 #include "big_integer.h"  // check include guards
+#include "big_integer_expr.h"
+#include "static_big_integer.h"
+#include "wide_int.h"
 
 TEST_CASE("Constructors") {
   std::ostringstream oss;
@@ -12,7 +16,7 @@ TEST_CASE("Constructors") {
   BigInteger a(100050008);
   oss << a << '\n';
 
-  BigInteger b(-9000000002ll);
+  BigInteger b(int64_t{-9000000002});
   oss << b << '\n';
 
   std::string x_str("1234056789837693278967293875983479857354986798379643835986743598760346745869837498567983769837");
@@ -37,6 +41,27 @@ TEST_CASE("Constructors") {
                            z_str.substr(1) + "\n");
 }
 
+TEST_CASE("LargeConversion") {
+  std::string digits;
+  for (size_t i = 0; i < 20'000; ++i) {
+    digits += static_cast<char>('0' + (i * 7 + i / 13) % 10);
+  }
+  digits[0] = '3';
+  const std::string sparse = "-1" + std::string(6'000, '0') + "2" + std::string(3'000, '0');
+
+  std::ostringstream oss;
+  oss << BigInteger(digits.c_str()) << ' ' << BigInteger(sparse.c_str());
+  REQUIRE(oss.str() == digits + ' ' + sparse);
+
+  std::istringstream iss(oss.str());
+  BigInteger a;
+  BigInteger b;
+  iss >> a >> b;
+  REQUIRE(a == BigInteger(digits.c_str()));
+  REQUIRE(b - BigInteger(("-2" + std::string(3'000, '0')).c_str()) ==
+          -BigInteger(("1" + std::string(9'001, '0')).c_str()));
+}
+
 TEST_CASE("UnaryOperators") {
   std::istringstream iss("1234567890123456789012345 -1245673456789345012389012");
   std::ostringstream oss;
@@ -73,6 +98,33 @@ TEST_CASE("Sum") {
   REQUIRE(-BigInteger(res.c_str()) + BigInteger(large.c_str()) == -BigInteger(large.c_str()));
 }
 
+TEST_CASE("MixedSignSum") {
+  const BigInteger power("18446744073709551616");
+  REQUIRE(power + BigInteger(-1) == BigInteger("18446744073709551615"));
+  REQUIRE(BigInteger(1) + -power == BigInteger("-18446744073709551615"));
+  REQUIRE(-power - -power == BigInteger(0));
+  REQUIRE_FALSE((-power - -power).IsNegative());
+  REQUIRE(BigInteger(0) - power == -power);
+  REQUIRE(-power + BigInteger(0) == -power);
+}
+
+TEST_CASE("LongCarryChains") {
+  BigInteger power(1);
+  for (int i = 0; i < 41; ++i) {
+    power *= 4294967296;
+  }
+  BigInteger all_ones = power - BigInteger(1);
+  REQUIRE(all_ones + BigInteger(1) == power);
+  REQUIRE(power - all_ones == BigInteger(1));
+  REQUIRE(all_ones + all_ones == power + all_ones - BigInteger(1));
+  REQUIRE(all_ones - (all_ones - BigInteger(1)) == BigInteger(1));
+  REQUIRE(all_ones < power);
+  REQUIRE(-power < -all_ones);
+  REQUIRE(all_ones + BigInteger(2) > power);
+  REQUIRE(all_ones != all_ones - BigInteger(1));
+  REQUIRE(all_ones - power * BigInteger(2) + power == BigInteger(-1));
+}
+
 TEST_CASE("CompoundSubtract") {
   BigInteger x(193);
   x -= -x;
@@ -108,7 +160,7 @@ TEST_CASE("CompoundMultiply") {
 TEST_CASE("Multiplication") {
   const std::string large(24, '9');
   const BigInteger x(1234567890);
-  const BigInteger y(9876543210ll);
+  const BigInteger y(int64_t{9876543210});
   const BigInteger res("12193263111263526900");
   REQUIRE(x * y == res);
   REQUIRE(x * -y == -res);
@@ -116,6 +168,295 @@ TEST_CASE("Multiplication") {
   REQUIRE(-x * -y == res);
   REQUIRE_THROWS_AS((void)(BigInteger(std::string(50'000, '1').c_str()) * BigInteger(large.c_str())),
                     BigIntegerOverflow);  // NOLINT
+
+  // The largest value below the size limit, 2^99662 - 1.
+  const BigInteger half = BigInteger(1) << 99661;
+  BigInteger max = half - 1 + half;
+  BigInteger min = -max;
+  REQUIRE_THROWS_AS(++max, BigIntegerOverflow);  // NOLINT
+  REQUIRE_THROWS_AS(--min, BigIntegerOverflow);  // NOLINT
+}
+
+TEST_CASE("LargeMultiplication") {
+  for (size_t size : {100, 1000, 6000}) {
+    const std::string nines(size, '9');
+    const std::string square = std::string(size - 1, '9') + "8" + std::string(size - 1, '0') + "1";
+    REQUIRE(BigInteger(nines.c_str()) * BigInteger(nines.c_str()) == BigInteger(square.c_str()));
+  }
+
+  const std::string long_nines(9000, '9');
+  const std::string short_nines(2500, '9');
+  const BigInteger expected = BigInteger(("1" + std::string(11500, '0')).c_str()) -
+                              BigInteger(("1" + std::string(9000, '0')).c_str()) -
+                              BigInteger(("1" + std::string(2500, '0')).c_str()) + BigInteger(1);
+  REQUIRE(BigInteger(long_nines.c_str()) * -BigInteger(short_nines.c_str()) == -expected);
+}
+
+TEST_CASE("HugeMultiplication") {
+  const size_t digit_max_size = BigInteger::digit_max_size;
+  BigInteger::digit_max_size = 200'000;
+  const std::string nines(50'000, '9');
+  const std::string square = std::string(49'999, '9') + "8" + std::string(49'999, '0') + "1";
+  REQUIRE(BigInteger(nines.c_str()) * BigInteger(nines.c_str()) == BigInteger(square.c_str()));
+  BigInteger::digit_max_size = digit_max_size;
+}
+
+TEST_CASE("LazyExpressions") {
+  const BigInteger a(("-" + std::string(80, '3')).c_str());
+  const BigInteger b(std::string(60, '7').c_str());
+  const BigInteger c("123456789012345678901234567890");
+  const BigInteger d(-42);
+  const BigInteger e(std::string(150, '9').c_str());
+  const BigInteger zero;
+
+  BigInteger result = Lazy(a) * b + Lazy(c) * d - e;
+  REQUIRE(result == a * b + c * d - e);
+  REQUIRE(BigInteger(Lazy(a) * b * c - Lazy(d)) == a * b * c - d);
+  REQUIRE(BigInteger(-(Lazy(a) * zero) + e - Lazy(e)) == zero);
+  REQUIRE(BigInteger(a - Lazy(b) * b) == a - b * b);
+  REQUIRE(BigInteger(-Lazy(a) * d) == -(a * d));
+
+  // Horner evaluation reusing one destination that also appears on the right-hand side.
+  BigInteger horner;
+  BigInteger expected;
+  for (const BigInteger& coefficient : {a, b, c, d, e}) {
+    Assign(horner, Lazy(horner) * c + coefficient);
+    expected = expected * c + coefficient;
+    REQUIRE(horner == expected);
+  }
+}
+
+TEST_CASE("LimbArena") {
+  const BigInteger a(std::string(300, '3').c_str());
+  LimbArena::Release();
+  LimbArena::ResetStats();
+  for (int i = 0; i < 100; ++i) {
+    BigInteger square = a * a;
+    square += a;
+    REQUIRE(square > a);
+  }
+  LimbArena::Stats stats = LimbArena::GetStats();
+  REQUIRE(stats.hits + stats.misses >= 100);
+  REQUIRE(stats.misses <= 4);
+
+  LimbArena::Release();
+  LimbArena::ResetStats();
+  const size_t max_cached_blocks = LimbArena::max_cached_blocks;
+  LimbArena::max_cached_blocks = 0;
+  for (int i = 0; i < 10; ++i) {
+    BigInteger square = a * a;
+  }
+  LimbArena::max_cached_blocks = max_cached_blocks;
+  REQUIRE(LimbArena::GetStats().hits == 0);
+  REQUIRE(LimbArena::GetStats().misses >= 10);
+
+  LimbArena::Release();
+  REQUIRE(LimbArena::GetStats().cached_bytes == 0);
+  {
+    const BigInteger big(std::string(10000, '7').c_str());
+    BigInteger square = big * big;
+  }
+  REQUIRE(LimbArena::GetStats().cached_bytes > 0);
+  REQUIRE(LimbArena::GetStats().cached_bytes <= LimbArena::max_cached_bytes);
+  const size_t max_cached_bytes = LimbArena::max_cached_bytes;
+  LimbArena::max_cached_bytes = 1024;
+  LimbArena::Release();
+  {
+    const BigInteger big(std::string(10000, '7').c_str());
+    BigInteger square = big * big;
+  }
+  LimbArena::max_cached_bytes = max_cached_bytes;
+  REQUIRE(LimbArena::GetStats().cached_bytes <= 1024);
+}
+
+TEST_CASE("ParallelMultiplication") {
+  const size_t digit_max_size = BigInteger::digit_max_size;
+  const size_t max_threads = BigInteger::max_threads;
+  const size_t parallel_grain_limbs = BigInteger::parallel_grain_limbs;
+  BigInteger::digit_max_size = 200'000;
+  const std::string sevens(60'000, '7');
+  const std::string threes(9'000, '3');
+  const BigInteger a(sevens.c_str());
+  const BigInteger b(threes.c_str());
+  const BigInteger product = a * b;
+  const BigInteger square = a * a;
+  std::ostringstream serial;
+  serial << product;
+
+  BigInteger::max_threads = 8;
+  BigInteger::parallel_grain_limbs = 64;
+  REQUIRE(BigInteger(sevens.c_str()) == a);
+  REQUIRE(a * b == product);
+  REQUIRE(a * a == square);
+  std::ostringstream parallel;
+  parallel << product;
+  REQUIRE(parallel.str() == serial.str());
+
+  BigInteger::max_threads = max_threads;
+  BigInteger::parallel_grain_limbs = parallel_grain_limbs;
+  BigInteger::digit_max_size = digit_max_size;
+}
+
+TEST_CASE("StaticBigInteger") {
+  using Static = StaticBigInteger<8>;
+  constexpr Static kFactorial20 = [] {
+    Static result = 1;
+    for (int64_t i = 2; i <= 20; ++i) {
+      result *= i;
+    }
+    return result;
+  }();
+  constexpr Static kLarge = "-123456789012345678901234567890123456789";
+  static_assert(kFactorial20 == Static(int64_t{2432902008176640000}));
+  static_assert(kLarge < Static(0) && -kLarge > kFactorial20);
+  static_assert(kLarge + (-kLarge) == Static(0) && !(kLarge - kLarge).IsNegative());
+  static_assert(kFactorial20 * kFactorial20 * kFactorial20 == Static("14400376622525549608547603031202889616850944000000000000"));
+
+  REQUIRE(BigInteger(kLarge) == BigInteger("-123456789012345678901234567890123456789"));
+  REQUIRE(BigInteger(kFactorial20 * kLarge) == BigInteger(kFactorial20) * BigInteger(kLarge));
+  REQUIRE(BigInteger(Static(-5) - Static("4294967296")) == BigInteger(int64_t{-4294967301}));
+  REQUIRE(Static(BigInteger("-98765432109876543210")) == Static("-98765432109876543210"));
+  REQUIRE(Static("-0") == Static(0));
+  REQUIRE_THROWS_AS(Static(BigInteger(std::string(100, '9').c_str())), BigIntegerOverflow);  // NOLINT
+  REQUIRE_THROWS_AS(kLarge * kLarge * kLarge, BigIntegerOverflow);  // NOLINT
+  REQUIRE_THROWS_AS(Static("12a"), BigIntegerInvalidFormat);  // NOLINT
+}
+
+TEST_CASE("WideInt") {
+  static_assert(std::is_trivially_copyable_v<Int256> && sizeof(Int256) == 32);
+  static_assert(std::is_trivially_copyable_v<WideInt<1024, false>>);
+
+  const BigInteger modulus = BigInteger(1) << 256;
+  const BigInteger values[] = {BigInteger(0), BigInteger(-1), BigInteger("340282366920938463463374607431768211455"),
+                               -(BigInteger(1) << 255), (BigInteger(1) << 255) - 1,
+                               BigInteger("-98765432109876543210987654321098765432109876543210")};
+  for (const BigInteger& a : values) {
+    REQUIRE(BigInteger(Int256(a)) == a);
+    for (const BigInteger& b : values) {
+      Int256 x(a);
+      Int256 y(b);
+      REQUIRE((BigInteger(x * y) - a * b) % modulus == 0);
+      REQUIRE((BigInteger(x + y) - (a + b)) % modulus == 0);
+      REQUIRE((BigInteger(x - y) - (a - b)) % modulus == 0);
+      REQUIRE((x < y) == (a < b));
+      REQUIRE((x == y) == (a == b));
+    }
+  }
+
+  REQUIRE(Int128(-1) * Int128(-1) == Int128(1));
+  REQUIRE(UInt128(0) - UInt128(1) == UInt128(BigInteger("340282366920938463463374607431768211455")));
+  REQUIRE(UInt128(0) < UInt128(-1));
+  REQUIRE(Int128(-5) < Int128(3));
+  REQUIRE(~Int256(0) == Int256(-1));
+
+  WideInt<1024, false> wide(BigInteger(-1) + (BigInteger(1) << 1024) - (BigInteger(1) << 600));
+  wide += WideInt<1024, false>(BigInteger(1) << 600);
+  wide -= WideInt<1024, false>(BigInteger(2));
+  REQUIRE(BigInteger(wide) == (BigInteger(1) << 1024) - 3);
+
+  REQUIRE_THROWS_AS(Int128(BigInteger(1) << 127), BigIntegerOverflow);  // NOLINT
+  REQUIRE_THROWS_AS(UInt128(BigInteger(-1)), BigIntegerOverflow);  // NOLINT
+  REQUIRE_THROWS_AS(UInt128(BigInteger(1) << 128), BigIntegerOverflow);  // NOLINT
+  REQUIRE(BigInteger(Int128(-(BigInteger(1) << 127))) == -(BigInteger(1) << 127));
+}
+
+TEST_CASE("BatchOperations") {
+  std::vector<BigInteger> l = {0, -7, BigInteger("123456789012345678901234567890"), BigInteger(-1) << 300, 5};
+  std::vector<BigInteger> r = {3, 7, BigInteger("-98765432109876543210"), BigInteger(1) << 300, 0};
+  std::vector<BigInteger> sums(l.size());
+  std::vector<BigInteger> products(l.size(), BigInteger(1) << 500);
+  AddMany(l.data(), r.data(), sums.data(), l.size());
+  MulMany(l.data(), r.data(), products.data(), l.size());
+  for (size_t i = 0; i < l.size(); ++i) {
+    REQUIRE(sums[i] == l[i] + r[i]);
+    REQUIRE(products[i] == l[i] * r[i]);
+  }
+  std::vector<BigInteger> in_place = l;
+  MulMany(in_place.data(), r.data(), in_place.data(), l.size());
+  AddMany(l.data(), in_place.data(), in_place.data(), l.size());
+  for (size_t i = 0; i < l.size(); ++i) {
+    REQUIRE(in_place[i] == l[i] * r[i] + l[i]);
+  }
+
+  BigInteger total = 0;
+  BigInteger product = 1;
+  for (size_t i = 0; i < l.size(); ++i) {
+    total += l[i] + r[i];
+    product *= l[i] + r[i] - 1;
+  }
+  std::vector<BigInteger> terms = l;
+  terms.insert(terms.end(), r.begin(), r.end());
+  REQUIRE(SumReduce(terms.data(), terms.size()) == total);
+  REQUIRE(SumReduce(nullptr, 0) == 0);
+  for (BigInteger& sum : sums) {
+    --sum;
+  }
+  REQUIRE(ProductTree(sums.data(), sums.size()) == product);
+  REQUIRE(ProductTree(nullptr, 0) == 1);
+
+  BigInteger factorial = 1;
+  for (int64_t i = 1; i <= 300; ++i) {
+    factorial *= i;
+    REQUIRE(Factorial(static_cast<uint32_t>(i)) == factorial);
+  }
+  REQUIRE(Factorial(0) == 1);
+  for (uint32_t n = 0; n <= 60; ++n) {
+    for (uint32_t k = 0; k <= n + 1; ++k) {
+      BigInteger expected = k > n ? BigInteger(0) : Factorial(n) / (Factorial(k) * Factorial(n - k));
+      REQUIRE(Binomial(n, k) == expected);
+    }
+  }
+  REQUIRE(Binomial(1000, 500) == Factorial(1000) / (Factorial(500) * Factorial(500)));
+  BigInteger falling = 1;
+  for (uint32_t k = 0; k <= 500; ++k) {
+    REQUIRE(Binomial(100000, k) == falling);
+    falling = falling * int64_t{100000 - k} / int64_t{k + 1};
+  }
+  const BigInteger large_n(int64_t{4000000000});
+  REQUIRE(Binomial(4000000000, 2) == large_n * (large_n - 1) / 2);
+  REQUIRE(Binomial(4000000000, 3999999998) == large_n * (large_n - 1) / 2);
+  REQUIRE(Binomial(4294967295, 4294967295) == 1);
+}
+
+TEST_CASE("Serialization") {
+  const BigInteger values[] = {BigInteger(0), BigInteger(1), BigInteger(-1), BigInteger(int64_t{-9000000002}),
+                               BigInteger(("-" + std::string(2000, '7')).c_str()),
+                               BigInteger(std::string(500, '3').c_str())};
+  std::vector<unsigned char> buffer;
+  for (const BigInteger& value : values) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + value.SerializedSize());
+    REQUIRE(value.Serialize(buffer.data() + offset) == value.SerializedSize());
+  }
+  REQUIRE(BigInteger(0).SerializedSize() == 1);
+  REQUIRE(BigInteger(-1).SerializedSize() == 5);
+
+  size_t offset = 0;
+  for (const BigInteger& value : values) {
+    size_t consumed = 0;
+    REQUIRE(BigInteger::Deserialize(buffer.data() + offset, buffer.size() - offset, &consumed) == value);
+    REQUIRE(consumed == value.SerializedSize());
+    offset += consumed;
+  }
+  REQUIRE(offset == buffer.size());
+
+  const unsigned char negative_zero[] = {1};
+  const unsigned char truncated[] = {4, 1, 0, 0, 0, 2};
+  const unsigned char leading_zero[] = {2, 0, 0, 0, 0};
+  const unsigned char unterminated[] = {0x80, 0x80};
+  const unsigned char padded_header[] = {0x82, 0x00, 1, 0, 0, 0};
+  const unsigned char padded_zero[] = {0x80, 0x00};
+  const unsigned char header_overflow[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02};
+  const unsigned char header_too_long[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(negative_zero, 1), BigIntegerInvalidFormat);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(truncated, 6), BigIntegerInvalidFormat);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(leading_zero, 5), BigIntegerInvalidFormat);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(unterminated, 2), BigIntegerInvalidFormat);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(padded_header, 6), BigIntegerInvalidFormat);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(padded_zero, 2), BigIntegerInvalidFormat);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(header_overflow, 10), BigIntegerInvalidFormat);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(header_too_long, 11), BigIntegerInvalidFormat);  // NOLINT
+  REQUIRE_THROWS_AS(BigInteger::Deserialize(buffer.data(), 0), BigIntegerInvalidFormat);  // NOLINT
 }
 
 TEST_CASE("Increment") {
@@ -142,6 +483,49 @@ TEST_CASE("Decrement") {
   REQUIRE_FALSE(x.IsNegative());
 }
 
+TEST_CASE("IncrementCarry") {
+  BigInteger x("18446744073709551615");
+  REQUIRE(++x == BigInteger("18446744073709551616"));
+  REQUIRE(--x == BigInteger("18446744073709551615"));
+  x = -x;
+  REQUIRE(x-- == BigInteger("-18446744073709551615"));
+  REQUIRE(x == BigInteger("-18446744073709551616"));
+  REQUIRE(++x == BigInteger("-18446744073709551615"));
+
+  BigInteger sum;
+  for (int32_t i = 1; i <= 1000; ++i) {
+    sum += BigInteger("1000000000000000000000") * BigInteger(i);
+    sum -= BigInteger(i);
+  }
+  REQUIRE(sum == BigInteger("500500000000000000000000000") - BigInteger(500500));
+}
+
+TEST_CASE("Int64Operations") {
+  const int64_t min = INT64_MIN;
+  const int64_t max = INT64_MAX;
+  BigInteger x(max);
+  x += max;
+  REQUIRE(x == BigInteger("18446744073709551614"));
+  x -= min;
+  REQUIRE(x == BigInteger("27670116110564327422"));
+  x *= min;
+  REQUIRE(x == BigInteger("-255211775190703847579084211500116606976"));
+  x *= int64_t{0};
+  REQUIRE(x == 0);
+  REQUIRE_FALSE(x.IsNegative());
+  x -= int64_t{5};
+  REQUIRE(x == -5);
+
+  REQUIRE(BigInteger(min) == min);
+  REQUIRE(BigInteger(min) < min + 1);
+  REQUIRE(BigInteger("-9223372036854775809") < min);
+  REQUIRE(BigInteger("9223372036854775808") > max);
+  REQUIRE(BigInteger(max) >= max);
+  REQUIRE(BigInteger(max) <= max);
+  REQUIRE(BigInteger(0) != 1);
+  REQUIRE(BigInteger(-1) < 0);
+}
+
 template <class T>
 void CheckComparisonEqual(const T& lhs, const T& rhs) {
   REQUIRE(lhs == rhs);
@@ -195,6 +579,83 @@ TEST_CASE("RelationalOperators") {
   CheckComparisonEqual(negative_copy, negative);
 }
 
+TEST_CASE("Roots") {
+  REQUIRE(ISqrt(BigInteger(0)) == BigInteger(0));
+  REQUIRE(ISqrt(BigInteger(15)) == BigInteger(3));
+  REQUIRE(ISqrt(BigInteger(16)) == BigInteger(4));
+  REQUIRE(IRoot(BigInteger(-27), 3) == BigInteger(-3));
+  REQUIRE(IRoot(BigInteger(1000), 1) == BigInteger(1000));
+  REQUIRE(IRoot(BigInteger(1000), 64) == BigInteger(1));
+
+  const BigInteger root(("9" + std::string(700, '1')).c_str());
+  const BigInteger square = root * root;
+  REQUIRE(ISqrt(square) == root);
+  REQUIRE(ISqrt(square - BigInteger(1)) == root - BigInteger(1));
+  REQUIRE(ISqrt(square + root + root) == root);
+  for (uint32_t k : {3u, 5u, 10u}) {
+    BigInteger power(1);
+    for (uint32_t i = 0; i < k; ++i) {
+      power *= root;
+    }
+    REQUIRE(IRoot(power, k) == root);
+    REQUIRE(IRoot(power - BigInteger(1), k) == root - BigInteger(1));
+    REQUIRE(IRoot(power * BigInteger(2), k) >= root);
+  }
+  REQUIRE_THROWS_AS(ISqrt(BigInteger(-4)), BigIntegerInvalidRoot);  // NOLINT
+  REQUIRE_THROWS_AS(IRoot(BigInteger(8), 0), BigIntegerInvalidRoot);  // NOLINT
+}
+
+TEST_CASE("BitwiseOperators") {
+  REQUIRE((BigInteger(12) & BigInteger(10)) == BigInteger(8));
+  REQUIRE((BigInteger(12) | BigInteger(10)) == BigInteger(14));
+  REQUIRE((BigInteger(12) ^ BigInteger(10)) == BigInteger(6));
+  REQUIRE((BigInteger(-12) & BigInteger(10)) == BigInteger(0));
+  REQUIRE((BigInteger(-12) | BigInteger(10)) == BigInteger(-2));
+  REQUIRE((BigInteger(-12) ^ BigInteger(-10)) == BigInteger(2));
+  REQUIRE(~BigInteger(0) == BigInteger(-1));
+  REQUIRE(~BigInteger(-5) == BigInteger(4));
+
+  const BigInteger a(("-" + std::string(90, '7')).c_str());
+  const BigInteger b(std::string(70, '3').c_str());
+  for (const BigInteger& x : {a, -a, BigInteger(-1)}) {
+    for (const BigInteger& y : {b, -b, x, BigInteger(0)}) {
+      REQUIRE((x & y) + (x | y) == x + y);
+      REQUIRE((x ^ y) == (x | y) - (x & y));
+      REQUIRE((x & ~y) == (x ^ (x & y)));
+    }
+  }
+  BigInteger c = a;
+  c ^= b;
+  c ^= b;
+  REQUIRE(c == a);
+  REQUIRE((BigInteger(-1) & a) == a);
+}
+
+TEST_CASE("Shifts") {
+  REQUIRE((BigInteger(1) << 100) == BigInteger("1267650600228229401496703205376"));
+  REQUIRE((BigInteger("1267650600228229401496703205377") >> 100) == BigInteger(1));
+  REQUIRE((BigInteger(-5) >> 1) == BigInteger(-3));
+  REQUIRE((BigInteger(-4) >> 2) == BigInteger(-1));
+  REQUIRE((BigInteger(-1) >> 1000) == BigInteger(-1));
+  REQUIRE((BigInteger(5) >> 1000) == BigInteger(0));
+
+  const BigInteger a(("-" + std::string(90, '7')).c_str());
+  for (size_t shift : {0, 1, 31, 32, 33, 64, 95}) {
+    BigInteger power = BigInteger(1) << shift;
+    REQUIRE((a << shift) == a * power);
+    REQUIRE(((a << shift) >> shift) == a);
+    BigInteger b = a;
+    b >>= shift;
+    REQUIRE(b * power <= a);
+    REQUIRE(a < (b + BigInteger(1)) * power);
+  }
+  REQUIRE_THROWS_AS(BigInteger(1) << 1000000, BigIntegerOverflow);  // NOLINT
+
+  REQUIRE(BigInteger(0).PopCount() == 0);
+  REQUIRE(BigInteger(-255).PopCount() == 8);
+  REQUIRE(((BigInteger(1) << 300) - BigInteger(1)).PopCount() == 300);
+}
+
 #ifdef BIG_INTEGER_DIVISION_IMPLEMENTED
 
 TEST_CASE("CompoundDivision") {
@@ -210,7 +671,7 @@ TEST_CASE("CompoundDivision") {
 
 TEST_CASE("Division") {
   const BigInteger x(1234567890);
-  const BigInteger y(9876543210ll);
+  const BigInteger y(int64_t{9876543210});
 
   REQUIRE(x / y == BigInteger(0));
   REQUIRE(x / -y == BigInteger(0));
@@ -236,7 +697,7 @@ TEST_CASE("CompoundResidual") {
 
 TEST_CASE("Residual") {
   const BigInteger x(1234567890);
-  const BigInteger y(9876543210ll);
+  const BigInteger y(int64_t{9876543210});
 
   REQUIRE(x % y == x);
   REQUIRE(x % -y == x);
@@ -249,4 +710,95 @@ TEST_CASE("Residual") {
   REQUIRE(-y % -x == BigInteger(-90));
 }
 
+TEST_CASE("DivMod") {
+  const BigInteger x(1234567890);
+  const BigInteger y(int64_t{9876543210});
+  BigInteger remainder;
+
+  REQUIRE(y.DivMod(x, &remainder) == BigInteger(8));
+  REQUIRE(remainder == BigInteger(90));
+  REQUIRE((-y).DivMod(x, &remainder) == BigInteger(-8));
+  REQUIRE(remainder == BigInteger(-90));
+  REQUIRE(x.DivMod(-y, &remainder) == BigInteger(0));
+  REQUIRE(remainder == x);
+  REQUIRE(y.DivMod(x, nullptr) == BigInteger(8));
+
+  remainder = y;
+  REQUIRE(remainder.DivMod(remainder, &remainder) == BigInteger(1));
+  REQUIRE(remainder == BigInteger(0));
+  REQUIRE_THROWS_AS(x.DivMod(BigInteger(0), &remainder), BigIntegerDivisionByZero);  // NOLINT
+}
+
+TEST_CASE("LargeDivision") {
+  const BigInteger divisor(("-" + std::string(700, '9')).c_str());
+  const BigInteger quotient(("1" + std::string(2000, '2')).c_str());
+  const BigInteger remainder(std::string(650, '4').c_str());
+  const BigInteger dividend = divisor * quotient - remainder;
+
+  REQUIRE(dividend / divisor == quotient);
+  REQUIRE(dividend % divisor == -remainder);
+  REQUIRE(dividend / BigInteger(-7) * BigInteger(-7) + dividend % BigInteger(-7) == dividend);
+  REQUIRE(divisor / dividend == BigInteger(0));
+  REQUIRE(divisor % dividend == divisor);
+}
+
+TEST_CASE("PowMod") {
+  const BigInteger odd(std::string(120, '9').c_str());
+  const BigInteger even = odd * BigInteger(2);
+  const BigInteger base(("-" + std::string(150, '7')).c_str());
+  // Exact powers of the limb base have a reciprocal one limb longer than other moduli of their size.
+  const BigInteger two_64 = BigInteger(1) << 64;
+  const BigInteger two_128 = BigInteger(1) << 128;
+  for (const BigInteger& modulus : {odd, even, -odd, BigInteger(97), BigInteger(1024), two_64, two_128}) {
+    const BigInteger absolute = modulus.IsNegative() ? -modulus : modulus;
+    BigInteger power(1);
+    for (int exponent = 0; exponent < 40; ++exponent) {
+      BigInteger expected = power % modulus;
+      if (expected.IsNegative()) {
+        expected += absolute;
+      }
+      REQUIRE(PowMod(base, BigInteger(exponent), modulus) == expected);
+      power *= base;
+    }
+  }
+
+  BigInteger mersenne(1);
+  for (int i = 0; i < 521; ++i) {
+    mersenne *= 2;
+  }
+  mersenne -= 1;
+  REQUIRE(PowMod(BigInteger(3), mersenne - BigInteger(1), mersenne) == BigInteger(1));
+  REQUIRE(PowMod(BigInteger(3), mersenne, mersenne * BigInteger(4)) % mersenne == BigInteger(3));
+  REQUIRE(PowMod(BigInteger(5), BigInteger(0), BigInteger(1)) == BigInteger(0));
+  REQUIRE(PowMod(BigInteger(3), BigInteger(5), two_64) == BigInteger(243));
+  REQUIRE(PowMod(BigInteger(3), BigInteger(5), BigInteger(1) << 96) == BigInteger(243));
+  REQUIRE_THROWS_AS(PowMod(BigInteger(2), BigInteger(3), BigInteger(0)), BigIntegerDivisionByZero);  // NOLINT
+  REQUIRE_THROWS_AS(PowMod(BigInteger(2), BigInteger(-3), BigInteger(5)), BigIntegerNegativeExponent);  // NOLINT
+}
+
+TEST_CASE("Gcd") {
+  REQUIRE(Gcd(BigInteger(12), BigInteger(-18)) == BigInteger(6));
+  REQUIRE(Gcd(BigInteger(-7), BigInteger(0)) == BigInteger(7));
+  REQUIRE(Gcd(BigInteger(0), BigInteger(0)) == BigInteger(0));
+  REQUIRE(Lcm(BigInteger(-4), BigInteger(6)) == BigInteger(12));
+  REQUIRE(Lcm(BigInteger(5), BigInteger(0)) == BigInteger(0));
+
+  const BigInteger common(("3" + std::string(300, '1')).c_str());
+  const BigInteger p(std::string(500, '8').c_str());
+  const BigInteger q = p + BigInteger(1);
+  REQUIRE(Gcd(common * p, -common * q) == common);
+  REQUIRE(Gcd(common * p * p, common) == common);
+  REQUIRE(Lcm(common * p, common * q) == common * p * q);
+
+  const BigInteger pairs[][2] = {{common * p, common * q}, {-p, common}, {BigInteger(0), -q}, {q, BigInteger(1)},
+                                 {BigInteger(240), BigInteger(46)}, {common * p, p}};
+  for (const auto& pair : pairs) {
+    BigInteger x;
+    BigInteger y;
+    const BigInteger gcd = ExtendedGcd(pair[0], pair[1], &x, &y);
+    REQUIRE(gcd == Gcd(pair[0], pair[1]));
+    REQUIRE(pair[0] * x + pair[1] * y == gcd);
+  }
+}
+
 #endif  // BIG_INTEGER_DIVISION_IMPLEMENTED
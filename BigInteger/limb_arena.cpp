@@ -0,0 +1,107 @@
+#include "limb_arena.h"
+
+#include <vector>
+
+namespace {
+// Blocks of 2^kMinClassBits to 2^kMaxClassBits limbs are cached; larger ones always go to the heap.
+const size_t kMinClassBits = 3;
+const size_t kMaxClassBits = 22;
+const size_t kClassCount = kMaxClassBits - kMinClassBits + 1;
+
+struct ThreadArena {
+  ~ThreadArena();
+  void Release();
+
+  std::vector<uint32_t*> blocks[kClassCount];
+  size_t cached_bytes = 0;
+  LimbArena::Stats stats;
+};
+
+// Other thread-local LimbBuffers may be destroyed after the arena; they then free straight to the heap.
+thread_local bool arena_destroyed = false;
+
+ThreadArena::~ThreadArena() {
+  Release();
+  arena_destroyed = true;
+}
+
+void ThreadArena::Release() {
+  for (std::vector<uint32_t*>& cached : blocks) {
+    for (uint32_t* block : cached) {
+      delete[] block;
+    }
+    cached.clear();
+  }
+  cached_bytes = 0;
+}
+
+ThreadArena& LocalArena() {
+  static thread_local ThreadArena arena;
+  return arena;
+}
+
+size_t ClassBits(size_t capacity) {
+  size_t bits = kMinClassBits;
+  while ((size_t{1} << bits) < capacity) {
+    ++bits;
+  }
+  return bits;
+}
+}  // namespace
+
+uint32_t* LimbArena::Allocate(size_t& capacity) {
+  size_t bits = ClassBits(capacity);
+  capacity = size_t{1} << bits;
+  if (bits <= kMaxClassBits && !arena_destroyed) {
+    ThreadArena& arena = LocalArena();
+    std::vector<uint32_t*>& cached = arena.blocks[bits - kMinClassBits];
+    if (!cached.empty()) {
+      uint32_t* block = cached.back();
+      cached.pop_back();
+      arena.cached_bytes -= capacity * sizeof(uint32_t);
+      ++arena.stats.hits;
+      return block;
+    }
+    ++arena.stats.misses;
+  }
+  return new uint32_t[capacity];
+}
+
+void LimbArena::Deallocate(uint32_t* block, size_t capacity) {
+  if (block == nullptr) {
+    return;
+  }
+  size_t bits = ClassBits(capacity);
+  if (bits <= kMaxClassBits && !arena_destroyed && (size_t{1} << bits) == capacity) {
+    ThreadArena& arena = LocalArena();
+    std::vector<uint32_t*>& cached = arena.blocks[bits - kMinClassBits];
+    size_t bytes = capacity * sizeof(uint32_t);
+    if (cached.size() < max_cached_blocks && arena.cached_bytes + bytes <= max_cached_bytes) {
+      cached.push_back(block);
+      arena.cached_bytes += bytes;
+      return;
+    }
+  }
+  delete[] block;
+}
+
+LimbArena::Stats LimbArena::GetStats() {
+  if (arena_destroyed) {
+    return Stats{};
+  }
+  Stats stats = LocalArena().stats;
+  stats.cached_bytes = LocalArena().cached_bytes;
+  return stats;
+}
+
+void LimbArena::ResetStats() {
+  if (!arena_destroyed) {
+    LocalArena().stats = Stats{};
+  }
+}
+
+void LimbArena::Release() {
+  if (!arena_destroyed) {
+    LocalArena().Release();
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef BIGINTEGER__LIMB_ARENA_H_
+#define BIGINTEGER__LIMB_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Per-thread cache of heap blocks for LimbBuffer. Blocks come in power-of-two size classes; a freed
+// block is kept by the freeing thread for its class and handed out again before any new allocation, so
+// temporaries of similar sizes stop reaching the global allocator and contending on it.
+class LimbArena {
+ public:
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    // Bytes currently held in the cache.
+    size_t cached_bytes = 0;
+  };
+
+  // Blocks cached per size class and thread; 0 disables caching.
+  inline static size_t max_cached_blocks = 32;
+  // Bytes cached per thread over all classes. The per-class cap alone would let a thread that once ran
+  // a large multiplication keep up to 32 blocks of every class up to 16 MiB; blocks that would exceed
+  // this budget go back to the heap instead.
+  inline static size_t max_cached_bytes = size_t{8} << 20;
+
+  // Returns a block of at least capacity limbs and rounds capacity up to the block's real size.
+  static uint32_t* Allocate(size_t& capacity);
+  static void Deallocate(uint32_t* block, size_t capacity);
+
+  // Counters of the calling thread: hits are allocations served from its cache.
+  static Stats GetStats();
+  static void ResetStats();
+  // Frees the blocks cached by the calling thread.
+  static void Release();
+};
+
+#endif //BIGINTEGER__LIMB_ARENA_H_
@@ -0,0 +1,168 @@
+#ifndef BIGINTEGER__LIMB_BUFFER_H_
+#define BIGINTEGER__LIMB_BUFFER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "limb_arena.h"
+
+// Vector-like storage for BigInteger limbs. Up to inline_capacity limbs (two 64-bit words) live inside
+// the object itself, so small values never touch the heap; larger values spill to a block from the
+// per-thread LimbArena.
+class LimbBuffer {
+ public:
+  using value_type = u_int32_t;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+  static const size_t inline_capacity = 4;
+
+  LimbBuffer() = default;
+
+  LimbBuffer(const LimbBuffer& other) {
+    assign(other.begin(), other.end());
+  }
+
+  LimbBuffer(LimbBuffer&& other) noexcept {
+    *this = std::move(other);
+  }
+
+  ~LimbBuffer() {
+    LimbArena::Deallocate(heap_, capacity_);
+  }
+
+  LimbBuffer& operator=(const LimbBuffer& other) {
+    if (this != &other) {
+      assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  LimbBuffer& operator=(LimbBuffer&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+    if (other.heap_ != nullptr) {
+      LimbArena::Deallocate(heap_, capacity_);
+      heap_ = other.heap_;
+      capacity_ = other.capacity_;
+      other.heap_ = nullptr;
+      other.capacity_ = inline_capacity;
+    } else {
+      std::copy(other.inline_, other.inline_ + other.size_, data());
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+    return *this;
+  }
+
+  template <class InputIt>
+  void assign(InputIt first, InputIt last) {
+    size_t count = static_cast<size_t>(last - first);
+    size_ = 0;
+    reserve(count);
+    std::copy(first, last, data());
+    size_ = count;
+  }
+
+  [[nodiscard]] size_t size() const {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] size_t capacity() const {
+    return capacity_;
+  }
+
+  value_type* data() {
+    return heap_ != nullptr ? heap_ : inline_;
+  }
+
+  const value_type* data() const {
+    return heap_ != nullptr ? heap_ : inline_;
+  }
+
+  iterator begin() {
+    return data();
+  }
+
+  iterator end() {
+    return data() + size_;
+  }
+
+  const_iterator begin() const {
+    return data();
+  }
+
+  const_iterator end() const {
+    return data() + size_;
+  }
+
+  value_type& operator[](size_t index) {
+    return data()[index];
+  }
+
+  const value_type& operator[](size_t index) const {
+    return data()[index];
+  }
+
+  value_type& back() {
+    return data()[size_ - 1];
+  }
+
+  const value_type& back() const {
+    return data()[size_ - 1];
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+    size_t new_capacity = std::max(capacity, capacity_ * 2);
+    value_type* heap = LimbArena::Allocate(new_capacity);
+    std::copy(begin(), end(), heap);
+    LimbArena::Deallocate(heap_, capacity_);
+    heap_ = heap;
+    capacity_ = new_capacity;
+  }
+
+  // New limbs are zero-initialized, as with std::vector.
+  void resize(size_t size) {
+    reserve(size);
+    if (size > size_) {
+      std::fill(data() + size_, data() + size, 0);
+    }
+    size_ = size;
+  }
+
+  void push_back(value_type value) {
+    reserve(size_ + 1);
+    data()[size_++] = value;
+  }
+
+  void pop_back() {
+    --size_;
+  }
+
+  void clear() {
+    size_ = 0;
+  }
+
+  void swap(LimbBuffer& other) noexcept {
+    LimbBuffer tmp = std::move(other);
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+ private:
+  value_type* heap_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = inline_capacity;
+  value_type inline_[inline_capacity] = {};
+};
+
+#endif //BIGINTEGER__LIMB_BUFFER_H_
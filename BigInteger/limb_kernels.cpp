@@ -0,0 +1,261 @@
+#include "limb_kernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIMB_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+using Digit = uint32_t;
+using DoubleDigit = uint64_t;
+
+// Below this many limbs the dispatch and setup cost more than the vector loop saves.
+const size_t kSimdMinSize = 16;
+
+Digit AddScalar(Digit* out, const Digit* a, const Digit* b, size_t count, Digit carry) {
+  DoubleDigit sum = carry;
+  for (size_t i = 0; i < count; ++i) {
+    sum += static_cast<DoubleDigit>(a[i]) + b[i];
+    out[i] = static_cast<Digit>(sum);
+    sum >>= 32;
+  }
+  return static_cast<Digit>(sum);
+}
+
+Digit SubScalar(Digit* out, const Digit* a, const Digit* b, size_t count, Digit borrow) {
+  for (size_t i = 0; i < count; ++i) {
+    DoubleDigit subtrahend = static_cast<DoubleDigit>(b[i]) + borrow;
+    borrow = a[i] < subtrahend;
+    out[i] = static_cast<Digit>(a[i] - subtrahend);
+  }
+  return borrow;
+}
+
+Digit PropagateCarry(Digit* out, const Digit* a, size_t count, Digit carry) {
+  for (size_t i = 0; i < count; ++i) {
+    Digit digit = a[i];
+    out[i] = digit + carry;
+    carry = out[i] < digit;
+  }
+  return carry;
+}
+
+Digit PropagateBorrow(Digit* out, const Digit* a, size_t count, Digit borrow) {
+  for (size_t i = 0; i < count; ++i) {
+    Digit digit = a[i];
+    out[i] = digit - borrow;
+    borrow = digit < borrow;
+  }
+  return borrow;
+}
+
+// Index of the highest limb where a and b differ, or count if they are equal.
+size_t FindTopDifferenceScalar(const Digit* a, const Digit* b, size_t count) {
+  for (size_t i = count; i > 0; --i) {
+    if (a[i - 1] != b[i - 1]) {
+      return i - 1;
+    }
+  }
+  return count;
+}
+
+// Carries between lanes are resolved with bit masks instead of a serial chain: with G the lanes that
+// overflow on their own and P the lanes that overflow only if a carry arrives, the lanes receiving a
+// carry are ((G << 1 | carry_in) + P) ^ P and the bit just above the lanes is the block's carry out.
+// Subtraction uses the same identity with borrows.
+unsigned ResolveCarries(unsigned generate, unsigned propagate, unsigned carry_in) {
+  return (((generate << 1) | carry_in) + propagate) ^ propagate;
+}
+
+#ifdef LIMB_KERNELS_X86
+__attribute__((target("avx2"))) __m256i LaneMask8(unsigned mask) {
+  const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  __m256i broadcast = _mm256_set1_epi32(static_cast<int>(mask));
+  return _mm256_cmpeq_epi32(_mm256_and_si256(broadcast, bits), bits);
+}
+
+__attribute__((target("avx2"))) Digit AddAvx2(Digit* out, const Digit* a, const Digit* b, size_t count, Digit carry) {
+  const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+  const __m256i ones = _mm256_set1_epi32(-1);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i sum = _mm256_add_epi32(va, vb);
+    __m256i overflow = _mm256_cmpgt_epi32(_mm256_xor_si256(va, sign), _mm256_xor_si256(sum, sign));
+    __m256i saturated = _mm256_cmpeq_epi32(sum, ones);
+    unsigned generate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(overflow)));
+    unsigned propagate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(saturated)));
+    unsigned carries = ResolveCarries(generate, propagate, carry);
+    sum = _mm256_sub_epi32(sum, LaneMask8(carries));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), sum);
+    carry = (carries >> 8) & 1;
+  }
+  return AddScalar(out + i, a + i, b + i, count - i, carry);
+}
+
+__attribute__((target("avx2"))) Digit SubAvx2(Digit* out, const Digit* a, const Digit* b, size_t count, Digit borrow) {
+  const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i difference = _mm256_sub_epi32(va, vb);
+    __m256i underflow = _mm256_cmpgt_epi32(_mm256_xor_si256(vb, sign), _mm256_xor_si256(va, sign));
+    __m256i exhausted = _mm256_cmpeq_epi32(difference, zero);
+    unsigned generate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(underflow)));
+    unsigned propagate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(exhausted)));
+    unsigned borrows = ResolveCarries(generate, propagate, borrow);
+    difference = _mm256_add_epi32(difference, LaneMask8(borrows));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), difference);
+    borrow = (borrows >> 8) & 1;
+  }
+  return SubScalar(out + i, a + i, b + i, count - i, borrow);
+}
+
+__attribute__((target("avx2"))) size_t FindTopDifferenceAvx2(const Digit* a, const Digit* b, size_t count) {
+  size_t i = count;
+  for (; i >= 8; i -= 8) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i - 8));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i - 8));
+    unsigned equal = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(va, vb))));
+    if (equal != 0xFF) {
+      return FindTopDifferenceScalar(a + i - 8, b + i - 8, 8) + i - 8;
+    }
+  }
+  size_t top = FindTopDifferenceScalar(a, b, i);
+  return top == i ? count : top;
+}
+
+__attribute__((target("sse4.1"))) __m128i LaneMask4(unsigned mask) {
+  const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+  __m128i broadcast = _mm_set1_epi32(static_cast<int>(mask));
+  return _mm_cmpeq_epi32(_mm_and_si128(broadcast, bits), bits);
+}
+
+__attribute__((target("sse4.1"))) Digit AddSse41(Digit* out, const Digit* a, const Digit* b, size_t count, Digit carry) {
+  const __m128i sign = _mm_set1_epi32(INT32_MIN);
+  const __m128i ones = _mm_set1_epi32(-1);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    __m128i sum = _mm_add_epi32(va, vb);
+    __m128i overflow = _mm_cmpgt_epi32(_mm_xor_si128(va, sign), _mm_xor_si128(sum, sign));
+    __m128i saturated = _mm_cmpeq_epi32(sum, ones);
+    unsigned generate = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(overflow)));
+    unsigned propagate = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(saturated)));
+    unsigned carries = ResolveCarries(generate, propagate, carry);
+    sum = _mm_sub_epi32(sum, LaneMask4(carries));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), sum);
+    carry = (carries >> 4) & 1;
+  }
+  return AddScalar(out + i, a + i, b + i, count - i, carry);
+}
+
+__attribute__((target("sse4.1"))) Digit SubSse41(Digit* out, const Digit* a, const Digit* b, size_t count, Digit borrow) {
+  const __m128i sign = _mm_set1_epi32(INT32_MIN);
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    __m128i difference = _mm_sub_epi32(va, vb);
+    __m128i underflow = _mm_cmpgt_epi32(_mm_xor_si128(vb, sign), _mm_xor_si128(va, sign));
+    __m128i exhausted = _mm_cmpeq_epi32(difference, zero);
+    unsigned generate = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(underflow)));
+    unsigned propagate = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(exhausted)));
+    unsigned borrows = ResolveCarries(generate, propagate, borrow);
+    difference = _mm_add_epi32(difference, LaneMask4(borrows));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), difference);
+    borrow = (borrows >> 4) & 1;
+  }
+  return SubScalar(out + i, a + i, b + i, count - i, borrow);
+}
+
+__attribute__((target("sse4.1"))) size_t FindTopDifferenceSse41(const Digit* a, const Digit* b, size_t count) {
+  size_t i = count;
+  for (; i >= 4; i -= 4) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i - 4));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i - 4));
+    __m128i difference = _mm_xor_si128(va, vb);
+    if (!_mm_testz_si128(difference, difference)) {
+      return FindTopDifferenceScalar(a + i - 4, b + i - 4, 4) + i - 4;
+    }
+  }
+  size_t top = FindTopDifferenceScalar(a, b, i);
+  return top == i ? count : top;
+}
+#endif
+
+struct LimbKernels {
+  Digit (*add)(Digit*, const Digit*, const Digit*, size_t, Digit) = AddScalar;
+  Digit (*sub)(Digit*, const Digit*, const Digit*, size_t, Digit) = SubScalar;
+  size_t (*find_top_difference)(const Digit*, const Digit*, size_t) = FindTopDifferenceScalar;
+};
+
+const LimbKernels& SelectKernels() {
+  static const LimbKernels kernels = [] {
+    LimbKernels selected;
+#ifdef LIMB_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      selected.add = AddAvx2;
+      selected.sub = SubAvx2;
+      selected.find_top_difference = FindTopDifferenceAvx2;
+    } else if (__builtin_cpu_supports("sse4.1")) {
+      selected.add = AddSse41;
+      selected.sub = SubSse41;
+      selected.find_top_difference = FindTopDifferenceSse41;
+    }
+#endif
+    return selected;
+  }();
+  return kernels;
+}
+
+size_t FindTopDifference(const Digit* a, const Digit* b, size_t count) {
+  return count < kSimdMinSize ? FindTopDifferenceScalar(a, b, count)
+                              : SelectKernels().find_top_difference(a, b, count);
+}
+}  // namespace
+
+Digit AddDigits(Digit* out, const Digit* a, size_t n, const Digit* b, size_t m) {
+  Digit carry = m < kSimdMinSize ? AddScalar(out, a, b, m, 0) : SelectKernels().add(out, a, b, m, 0);
+  return PropagateCarry(out + m, a + m, n - m, carry);
+}
+
+Digit SubDigits(Digit* out, const Digit* a, size_t n, const Digit* b, size_t m) {
+  Digit borrow = m < kSimdMinSize ? SubScalar(out, a, b, m, 0) : SelectKernels().sub(out, a, b, m, 0);
+  return PropagateBorrow(out + m, a + m, n - m, borrow);
+}
+
+int CompareDigits(const Digit* a, size_t n, const Digit* b, size_t m) {
+  if (n != m) {
+    return n < m ? -1 : 1;
+  }
+  size_t top = FindTopDifference(a, b, n);
+  if (top == n) {
+    return 0;
+  }
+  return a[top] < b[top] ? -1 : 1;
+}
+
+bool EqualDigits(const Digit* a, const Digit* b, size_t n) {
+  return FindTopDifference(a, b, n) == n;
+}
+
+size_t PopCountDigits(const Digit* a, size_t n) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+#if defined(__GNUC__) || defined(__clang__)
+    count += static_cast<size_t>(__builtin_popcount(a[i]));
+#else
+    for (Digit digit = a[i]; digit != 0; digit &= digit - 1) {
+      ++count;
+    }
+#endif
+  }
+  return count;
+}
@@ -0,0 +1,24 @@
+#ifndef BIGINTEGER__LIMB_KERNELS_H_
+#define BIGINTEGER__LIMB_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Linear kernels over little-endian 32-bit limb spans. On x86-64 they dispatch at run time to AVX2 or
+// SSE4.1 implementations and fall back to scalar loops elsewhere; all variants give identical results.
+
+// out[0, n) = a[0, n) + b[0, m) for n >= m; returns the carry out of the top limb. out may alias a or b.
+uint32_t AddDigits(uint32_t* out, const uint32_t* a, size_t n, const uint32_t* b, size_t m);
+
+// out[0, n) = a[0, n) - b[0, m) for n >= m; returns the borrow out of the top limb. out may alias a or b.
+uint32_t SubDigits(uint32_t* out, const uint32_t* a, size_t n, const uint32_t* b, size_t m);
+
+// Compares two normalized magnitudes; returns -1, 0 or 1.
+int CompareDigits(const uint32_t* a, size_t n, const uint32_t* b, size_t m);
+
+bool EqualDigits(const uint32_t* a, const uint32_t* b, size_t n);
+
+// Number of set bits in a[0, n).
+size_t PopCountDigits(const uint32_t* a, size_t n);
+
+#endif //BIGINTEGER__LIMB_KERNELS_H_
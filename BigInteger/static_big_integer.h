@@ -0,0 +1,256 @@
+#ifndef BIGINTEGER__STATIC_BIG_INTEGER_H_
+#define BIGINTEGER__STATIC_BIG_INTEGER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "big_integer.h"
+
+// Fixed-capacity signed integer of at most Limbs 32-bit limbs whose parsing, arithmetic and comparisons
+// are constexpr, so tables of large constants can be built at compile time and then converted to
+// BigInteger. A result that does not fit throws BigIntegerOverflow, which makes it a compile error in a
+// constant expression.
+template <size_t Limbs>
+class StaticBigInteger {
+  static_assert(Limbs > 0, "StaticBigInteger needs at least one limb");
+
+ public:
+  using DigitType = uint32_t;
+  using DoubleDigitType = uint64_t;
+  static const size_t capacity = Limbs;
+
+  constexpr StaticBigInteger() = default;
+
+  constexpr StaticBigInteger(int32_t num) : StaticBigInteger(int64_t{num}) { // NOLINT
+  }
+
+  constexpr StaticBigInteger(int64_t num) { // NOLINT
+    is_negative_ = num < 0;
+    DoubleDigitType magnitude = is_negative_ ? DoubleDigitType{0} - static_cast<DoubleDigitType>(num)
+                                             : static_cast<DoubleDigitType>(num);
+    for (; magnitude != 0; magnitude >>= 32) {
+      PushDigit(static_cast<DigitType>(magnitude));
+    }
+  }
+
+  // Decimal literal with an optional leading '-'; any other character throws BigIntegerInvalidFormat.
+  constexpr StaticBigInteger(const char* char_arr) { // NOLINT
+    bool is_negative = *char_arr == '-';
+    if (is_negative) {
+      ++char_arr;
+    }
+    if (*char_arr == '\0') {
+      throw BigIntegerInvalidFormat{};
+    }
+    for (; *char_arr != '\0'; ++char_arr) {
+      if (*char_arr < '0' || *char_arr > '9') {
+        throw BigIntegerInvalidFormat{};
+      }
+      MulAddDigit(10, static_cast<DigitType>(*char_arr - '0'));
+    }
+    is_negative_ = is_negative && size_ != 0;
+  }
+
+  // Throws BigIntegerOverflow if value needs more than Limbs limbs.
+  explicit StaticBigInteger(const BigInteger& value) {
+    if (value.digits_.size() > Limbs) {
+      throw BigIntegerOverflow{};
+    }
+    for (DigitType digit : value.digits_) {
+      digits_[size_++] = digit;
+    }
+    is_negative_ = value.is_negative_;
+  }
+
+  operator BigInteger() const { // NOLINT
+    BigInteger result;
+    result.digits_.assign(digits_, digits_ + size_);
+    result.is_negative_ = is_negative_;
+    return result;
+  }
+
+  [[nodiscard]] constexpr bool IsNegative() const {
+    return is_negative_;
+  }
+
+  // Little-endian limbs of the magnitude, size() of them, none for zero.
+  [[nodiscard]] constexpr const DigitType* data() const {
+    return digits_;
+  }
+
+  [[nodiscard]] constexpr size_t size() const {
+    return size_;
+  }
+
+  constexpr StaticBigInteger operator+() const {
+    return *this;
+  }
+
+  constexpr StaticBigInteger operator-() const {
+    StaticBigInteger result = *this;
+    result.is_negative_ = !is_negative_ && size_ != 0;
+    return result;
+  }
+
+  friend constexpr StaticBigInteger operator+(const StaticBigInteger& l, const StaticBigInteger& r) {
+    return Sum(l, r, false);
+  }
+
+  friend constexpr StaticBigInteger operator-(const StaticBigInteger& l, const StaticBigInteger& r) {
+    return Sum(l, r, true);
+  }
+
+  friend constexpr StaticBigInteger operator*(const StaticBigInteger& l, const StaticBigInteger& r) {
+    StaticBigInteger result;
+    if (l.size_ == 0 || r.size_ == 0) {
+      return result;
+    }
+    if (l.size_ + r.size_ - 1 > Limbs) {
+      throw BigIntegerOverflow{};
+    }
+    DigitType product[2 * Limbs] = {};
+    for (size_t i = 0; i < l.size_; ++i) {
+      DoubleDigitType carry = 0;
+      for (size_t j = 0; j < r.size_; ++j) {
+        DoubleDigitType current = static_cast<DoubleDigitType>(l.digits_[i]) * r.digits_[j] + product[i + j] + carry;
+        product[i + j] = static_cast<DigitType>(current);
+        carry = current >> 32;
+      }
+      product[i + r.size_] = static_cast<DigitType>(carry);
+    }
+    result.size_ = l.size_ + r.size_;
+    while (result.size_ > 0 && product[result.size_ - 1] == 0) {
+      --result.size_;
+    }
+    if (result.size_ > Limbs) {
+      throw BigIntegerOverflow{};
+    }
+    for (size_t i = 0; i < result.size_; ++i) {
+      result.digits_[i] = product[i];
+    }
+    result.is_negative_ = l.is_negative_ != r.is_negative_;
+    return result;
+  }
+
+  constexpr StaticBigInteger& operator+=(const StaticBigInteger& other) {
+    return *this = *this + other;
+  }
+
+  constexpr StaticBigInteger& operator-=(const StaticBigInteger& other) {
+    return *this = *this - other;
+  }
+
+  constexpr StaticBigInteger& operator*=(const StaticBigInteger& other) {
+    return *this = *this * other;
+  }
+
+  friend constexpr bool operator==(const StaticBigInteger& l, const StaticBigInteger& r) {
+    return Compare(l, r) == 0;
+  }
+
+  friend constexpr bool operator!=(const StaticBigInteger& l, const StaticBigInteger& r) {
+    return Compare(l, r) != 0;
+  }
+
+  friend constexpr bool operator<(const StaticBigInteger& l, const StaticBigInteger& r) {
+    return Compare(l, r) < 0;
+  }
+
+  friend constexpr bool operator<=(const StaticBigInteger& l, const StaticBigInteger& r) {
+    return Compare(l, r) <= 0;
+  }
+
+  friend constexpr bool operator>(const StaticBigInteger& l, const StaticBigInteger& r) {
+    return Compare(l, r) > 0;
+  }
+
+  friend constexpr bool operator>=(const StaticBigInteger& l, const StaticBigInteger& r) {
+    return Compare(l, r) >= 0;
+  }
+
+ private:
+  constexpr void PushDigit(DigitType digit) {
+    if (size_ == Limbs) {
+      throw BigIntegerOverflow{};
+    }
+    digits_[size_++] = digit;
+  }
+
+  // *this = *this * multiplier + addend on the magnitude.
+  constexpr void MulAddDigit(DigitType multiplier, DigitType addend) {
+    DoubleDigitType carry = addend;
+    for (size_t i = 0; i < size_; ++i) {
+      DoubleDigitType current = static_cast<DoubleDigitType>(digits_[i]) * multiplier + carry;
+      digits_[i] = static_cast<DigitType>(current);
+      carry = current >> 32;
+    }
+    if (carry != 0) {
+      PushDigit(static_cast<DigitType>(carry));
+    }
+  }
+
+  static constexpr int CompareMagnitudes(const StaticBigInteger& l, const StaticBigInteger& r) {
+    if (l.size_ != r.size_) {
+      return l.size_ < r.size_ ? -1 : 1;
+    }
+    for (size_t i = l.size_; i > 0; --i) {
+      if (l.digits_[i - 1] != r.digits_[i - 1]) {
+        return l.digits_[i - 1] < r.digits_[i - 1] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  static constexpr int Compare(const StaticBigInteger& l, const StaticBigInteger& r) {
+    if (l.is_negative_ != r.is_negative_) {
+      return l.is_negative_ ? -1 : 1;
+    }
+    int magnitude = CompareMagnitudes(l, r);
+    return l.is_negative_ ? -magnitude : magnitude;
+  }
+
+  static constexpr StaticBigInteger Sum(const StaticBigInteger& l, const StaticBigInteger& r, bool subtract) {
+    bool r_negative = r.is_negative_ != subtract;
+    StaticBigInteger result;
+    if (l.is_negative_ == r_negative) {
+      DoubleDigitType carry = 0;
+      size_t size = l.size_ > r.size_ ? l.size_ : r.size_;
+      for (size_t i = 0; i < size; ++i) {
+        carry += static_cast<DoubleDigitType>(i < l.size_ ? l.digits_[i] : 0) + (i < r.size_ ? r.digits_[i] : 0);
+        result.PushDigit(static_cast<DigitType>(carry));
+        carry >>= 32;
+      }
+      if (carry != 0) {
+        result.PushDigit(static_cast<DigitType>(carry));
+      }
+      result.is_negative_ = l.is_negative_;
+      return result;
+    }
+
+    int order = CompareMagnitudes(l, r);
+    if (order == 0) {
+      return result;
+    }
+    const StaticBigInteger& larger = order > 0 ? l : r;
+    const StaticBigInteger& smaller = order > 0 ? r : l;
+    DigitType borrow = 0;
+    for (size_t i = 0; i < larger.size_; ++i) {
+      DoubleDigitType subtrahend = static_cast<DoubleDigitType>(i < smaller.size_ ? smaller.digits_[i] : 0) + borrow;
+      borrow = larger.digits_[i] < subtrahend ? 1 : 0;
+      result.digits_[i] = static_cast<DigitType>(larger.digits_[i] - subtrahend);
+    }
+    result.size_ = larger.size_;
+    while (result.size_ > 0 && result.digits_[result.size_ - 1] == 0) {
+      --result.size_;
+    }
+    result.is_negative_ = order > 0 ? l.is_negative_ : r_negative;
+    return result;
+  }
+
+  // Little-endian limbs, zero above size_; zero has size_ == 0 and is never negative.
+  DigitType digits_[Limbs] = {};
+  size_t size_ = 0;
+  bool is_negative_ = false;
+};
+
+#endif //BIGINTEGER__STATIC_BIG_INTEGER_H_
@@ -0,0 +1,210 @@
+#ifndef BIGINTEGER__WIDE_INT_H_
+#define BIGINTEGER__WIDE_INT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "big_integer.h"
+#include "limb_kernels.h"
+
+// Stack-allocated integer of exactly Bits bits (a multiple of 32) with the wrap-around semantics of the
+// built-in types: arithmetic is modulo 2^Bits and signed values are two's complement. It is trivially
+// copyable and never allocates, so it can stand in for BigInteger in containers when values are bounded.
+// Conversion from a BigInteger that does not fit throws BigIntegerOverflow; conversion back is lossless.
+template <size_t Bits, bool Signed = true>
+class WideInt {
+  static_assert(Bits > 0 && Bits % 32 == 0, "WideInt width must be a positive multiple of 32 bits");
+
+ public:
+  using DigitType = uint32_t;
+  using DoubleDigitType = uint64_t;
+  static const size_t limbs = Bits / 32;
+
+  constexpr WideInt() = default;
+
+  constexpr WideInt(int32_t num) : WideInt(int64_t{num}) { // NOLINT
+  }
+
+  // Sign-extended into the upper limbs, then reduced modulo 2^Bits like a built-in conversion.
+  constexpr WideInt(int64_t num) { // NOLINT
+    DoubleDigitType bits = static_cast<DoubleDigitType>(num);
+    DigitType fill = num < 0 ? ~DigitType{0} : 0;
+    for (size_t i = 0; i < limbs; ++i) {
+      digits_[i] = i < 2 ? static_cast<DigitType>(bits >> (32 * i)) : fill;
+    }
+  }
+
+  explicit WideInt(const BigInteger& value) {
+    const LimbBuffer& digits = value.digits_;
+    if (digits.size() > limbs || (value.is_negative_ && !Signed)) {
+      throw BigIntegerOverflow{};
+    }
+    std::copy(digits.begin(), digits.end(), digits_);
+    if (Signed && digits.size() == limbs && (digits_[limbs - 1] >> 31) != 0) {
+      // Only -2^(Bits - 1) has its top bit set in both the magnitude and the two's complement form.
+      WideInt minimum;
+      minimum.digits_[limbs - 1] = DigitType{1} << 31;
+      if (!value.is_negative_ || *this != minimum) {
+        throw BigIntegerOverflow{};
+      }
+    }
+    if (value.is_negative_) {
+      *this = -*this;
+    }
+  }
+
+  operator BigInteger() const { // NOLINT
+    BigInteger result;
+    WideInt magnitude = IsNegative() ? -*this : *this;
+    size_t size = limbs;
+    while (size > 0 && magnitude.digits_[size - 1] == 0) {
+      --size;
+    }
+    result.digits_.assign(magnitude.digits_, magnitude.digits_ + size);
+    result.is_negative_ = IsNegative();
+    return result;
+  }
+
+  [[nodiscard]] constexpr bool IsNegative() const {
+    return Signed && (digits_[limbs - 1] >> 31) != 0;
+  }
+
+  // Little-endian limbs of the two's complement bit pattern.
+  [[nodiscard]] constexpr const DigitType* data() const {
+    return digits_;
+  }
+
+  WideInt operator+() const {
+    return *this;
+  }
+
+  WideInt operator-() const {
+    return WideInt{} - *this;
+  }
+
+  WideInt operator~() const {
+    WideInt result;
+    for (size_t i = 0; i < limbs; ++i) {
+      result.digits_[i] = ~digits_[i];
+    }
+    return result;
+  }
+
+  // Up to kKernelLimbs limbs the loops below have constant trip counts and are unrolled by the compiler;
+  // wider values go through the shared limb kernels, which vectorize from that size on.
+  WideInt& operator+=(const WideInt& other) {
+    if constexpr (limbs >= kKernelLimbs) {
+      AddDigits(digits_, digits_, limbs, other.digits_, limbs);
+    } else {
+      DoubleDigitType carry = 0;
+      for (size_t i = 0; i < limbs; ++i) {
+        carry += static_cast<DoubleDigitType>(digits_[i]) + other.digits_[i];
+        digits_[i] = static_cast<DigitType>(carry);
+        carry >>= 32;
+      }
+    }
+    return *this;
+  }
+
+  WideInt& operator-=(const WideInt& other) {
+    if constexpr (limbs >= kKernelLimbs) {
+      SubDigits(digits_, digits_, limbs, other.digits_, limbs);
+    } else {
+      DigitType borrow = 0;
+      for (size_t i = 0; i < limbs; ++i) {
+        DoubleDigitType difference = static_cast<DoubleDigitType>(digits_[i]) - other.digits_[i] - borrow;
+        digits_[i] = static_cast<DigitType>(difference);
+        borrow = static_cast<DigitType>(difference >> 63);
+      }
+    }
+    return *this;
+  }
+
+  // Only the low limbs of the product are formed; two's complement makes this right for signed values.
+  WideInt& operator*=(const WideInt& other) {
+    DigitType product[limbs] = {};
+    for (size_t i = 0; i < limbs; ++i) {
+      DoubleDigitType carry = 0;
+      for (size_t j = 0; i + j < limbs; ++j) {
+        carry += static_cast<DoubleDigitType>(digits_[i]) * other.digits_[j] + product[i + j];
+        product[i + j] = static_cast<DigitType>(carry);
+        carry >>= 32;
+      }
+    }
+    std::copy(product, product + limbs, digits_);
+    return *this;
+  }
+
+  friend WideInt operator+(WideInt l, const WideInt& r) {
+    return l += r;
+  }
+
+  friend WideInt operator-(WideInt l, const WideInt& r) {
+    return l -= r;
+  }
+
+  friend WideInt operator*(WideInt l, const WideInt& r) {
+    return l *= r;
+  }
+
+  friend constexpr bool operator==(const WideInt& l, const WideInt& r) {
+    for (size_t i = 0; i < limbs; ++i) {
+      if (l.digits_[i] != r.digits_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend constexpr bool operator!=(const WideInt& l, const WideInt& r) {
+    return !(l == r);
+  }
+
+  friend constexpr bool operator<(const WideInt& l, const WideInt& r) {
+    return Compare(l, r) < 0;
+  }
+
+  friend constexpr bool operator<=(const WideInt& l, const WideInt& r) {
+    return Compare(l, r) <= 0;
+  }
+
+  friend constexpr bool operator>(const WideInt& l, const WideInt& r) {
+    return Compare(l, r) > 0;
+  }
+
+  friend constexpr bool operator>=(const WideInt& l, const WideInt& r) {
+    return Compare(l, r) >= 0;
+  }
+
+  friend std::ostream& operator<<(std::ostream& ostream, const WideInt& other) {
+    return ostream << static_cast<BigInteger>(other);
+  }
+
+ private:
+  static const size_t kKernelLimbs = 16;
+
+  static constexpr int Compare(const WideInt& l, const WideInt& r) {
+    if (l.IsNegative() != r.IsNegative()) {
+      return l.IsNegative() ? -1 : 1;
+    }
+    // With equal signs the two's complement patterns order like unsigned numbers.
+    for (size_t i = limbs; i > 0; --i) {
+      if (l.digits_[i - 1] != r.digits_[i - 1]) {
+        return l.digits_[i - 1] < r.digits_[i - 1] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  DigitType digits_[limbs] = {};
+};
+
+using Int128 = WideInt<128>;
+using UInt128 = WideInt<128, false>;
+using Int256 = WideInt<256>;
+using UInt256 = WideInt<256, false>;
+using Int512 = WideInt<512>;
+using UInt512 = WideInt<512, false>;
+
+#endif //BIGINTEGER__WIDE_INT_H_
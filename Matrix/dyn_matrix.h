@@ -0,0 +1,411 @@
+#ifndef DYN_MATRIX_H
+#define DYN_MATRIX_H
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "matrix.h"
+#include "matrix_kernels.h"
+
+struct MatrixSizeMismatch {};
+
+enum class MatrixLayout { kRowMajor, kColumnMajor };
+
+// Matrix whose size is chosen at run time, stored on the heap with every
+// allocation aligned to 64 bytes. Rows (row-major) or columns (column-major)
+// are leading_dimension elements apart, which defaults to the compact stride;
+// a larger one pads each line, e.g. to keep lines on cache-line boundaries.
+template <class ValueType>
+class DynMatrix {
+ public:
+  static const size_t alignment = 64;
+
+  DynMatrix() = default;
+
+  DynMatrix(size_t rows, size_t columns,
+            MatrixLayout layout = MatrixLayout::kRowMajor,
+            size_t leading_dimension = 0)
+      : rows_(rows), columns_(columns), layout_(layout) {
+    size_t line = layout == MatrixLayout::kRowMajor ? columns : rows;
+    if (leading_dimension != 0 && leading_dimension < line) {
+      throw MatrixSizeMismatch();
+    }
+    leading_dimension_ = leading_dimension != 0 ? leading_dimension : line;
+    Allocate();
+  }
+
+  template <size_t N, size_t M>
+  explicit DynMatrix(const Matrix<ValueType, N, M>& matrix,
+                     MatrixLayout layout = MatrixLayout::kRowMajor)
+      : DynMatrix(N, M, layout) {
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < M; ++j) {
+        (*this)(i, j) = matrix(i, j);
+      }
+    }
+  }
+
+  DynMatrix(const DynMatrix& other)
+      : rows_(other.rows_),
+        columns_(other.columns_),
+        leading_dimension_(other.leading_dimension_),
+        layout_(other.layout_) {
+    Allocate();
+    std::copy(other.data_, other.data_ + StorageSize(), data_);
+  }
+
+  DynMatrix(DynMatrix&& other) noexcept { Swap(other); }
+
+  DynMatrix& operator=(const DynMatrix& other) {
+    if (this != &other) {
+      DynMatrix copy = other;
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  DynMatrix& operator=(DynMatrix&& other) noexcept {
+    DynMatrix moved = std::move(other);
+    Swap(moved);
+    return *this;
+  }
+
+  ~DynMatrix() { Deallocate(); }
+
+  // Throws MatrixSizeMismatch unless the sizes are N x M.
+  template <size_t N, size_t M>
+  explicit operator Matrix<ValueType, N, M>() const {
+    if (rows_ != N || columns_ != M) {
+      throw MatrixSizeMismatch();
+    }
+    Matrix<ValueType, N, M> result;
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < M; ++j) {
+        result(i, j) = (*this)(i, j);
+      }
+    }
+    return result;
+  }
+
+  size_t RowsNumber() const { return rows_; }
+
+  size_t ColumnsNumber() const { return columns_; }
+
+  MatrixLayout Layout() const { return layout_; }
+
+  size_t LeadingDimension() const { return leading_dimension_; }
+
+  ValueType* Data() { return data_; }
+
+  const ValueType* Data() const { return data_; }
+
+  ValueType& At(size_t a, size_t b) {
+    if (a >= rows_ || b >= columns_) {
+      throw MatrixOutOfRange();
+    }
+    return (*this)(a, b);
+  }
+
+  const ValueType& At(size_t a, size_t b) const {
+    if (a >= rows_ || b >= columns_) {
+      throw MatrixOutOfRange();
+    }
+    return (*this)(a, b);
+  }
+
+  ValueType& operator()(size_t a, size_t b) { return data_[Offset(a, b)]; }
+
+  const ValueType& operator()(size_t a, size_t b) const {
+    return data_[Offset(a, b)];
+  }
+
+  DynMatrix operator+(const DynMatrix& other) const {
+    DynMatrix result = *this;
+    return result += other;
+  }
+
+  DynMatrix operator-(const DynMatrix& other) const {
+    DynMatrix result = *this;
+    return result -= other;
+  }
+
+  DynMatrix operator*(const ValueType& value) const {
+    DynMatrix result = *this;
+    return result *= value;
+  }
+
+  DynMatrix operator/(const ValueType& value) const {
+    DynMatrix result = *this;
+    return result /= value;
+  }
+
+  DynMatrix& operator+=(const DynMatrix& other) {
+    Combine(other, [](const ValueType* a, ValueType* out, size_t size) {
+      matrix_kernels::Add(out, a, out, size);
+    });
+    return *this;
+  }
+
+  DynMatrix& operator-=(const DynMatrix& other) {
+    Combine(other, [](const ValueType* a, ValueType* out, size_t size) {
+      matrix_kernels::Subtract(out, a, out, size);
+    });
+    return *this;
+  }
+
+  DynMatrix& operator*=(const ValueType& value) {
+    ForEachLine([&value](ValueType* line, size_t size) {
+      matrix_kernels::Scale(line, value, line, size);
+    });
+    return *this;
+  }
+
+  DynMatrix& operator/=(const ValueType& value) {
+    ForEachLine([&value](ValueType* line, size_t size) {
+      matrix_kernels::Divide(line, value, line, size);
+    });
+    return *this;
+  }
+
+  // matrix += alpha * other in a single pass over both, with the same free
+  // form as Axpy for Matrix so that generic code can take either type.
+  friend DynMatrix& Axpy(DynMatrix& matrix, const ValueType& alpha,
+                         const DynMatrix& other) {
+    matrix.Combine(other,
+                   [&alpha](const ValueType* x, ValueType* y, size_t size) {
+                     matrix_kernels::Axpy(alpha, x, y, size);
+                   });
+    return matrix;
+  }
+
+  // The product takes the layout of the left operand. Both operands are
+  // brought to the layout the kernels need (a column-major matrix is the
+  // row-major storage of its transpose), copying only when they differ.
+  DynMatrix operator*(const DynMatrix& other) const {
+    if (columns_ != other.rows_) {
+      throw MatrixSizeMismatch();
+    }
+    DynMatrix result(rows_, other.columns_, layout_);
+    if (layout_ == MatrixLayout::kRowMajor) {
+      Multiply(*this, other, result, MatrixLayout::kRowMajor);
+    } else {
+      // C^T = B^T * A^T, all three read as row-major transposes.
+      Multiply(other, *this, result, MatrixLayout::kColumnMajor);
+    }
+    return result;
+  }
+
+  DynMatrix& operator*=(const DynMatrix& other) {
+    return *this = *this * other;
+  }
+
+  bool operator==(const DynMatrix& other) const {
+    if (rows_ != other.rows_ || columns_ != other.columns_) {
+      return false;
+    }
+    if (SameShape(other) && IsCompact()) {
+      return matrix_kernels::Equal(data_, other.data_, StorageSize());
+    }
+    for (size_t i = 0; i < rows_; ++i) {
+      for (size_t j = 0; j < columns_; ++j) {
+        if ((*this)(i, j) != other(i, j)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const DynMatrix& other) const { return !(*this == other); }
+
+ private:
+  size_t Offset(size_t a, size_t b) const {
+    return layout_ == MatrixLayout::kRowMajor ? a * leading_dimension_ + b
+                                              : b * leading_dimension_ + a;
+  }
+
+  size_t Lines() const {
+    return layout_ == MatrixLayout::kRowMajor ? rows_ : columns_;
+  }
+
+  size_t LineSize() const {
+    return layout_ == MatrixLayout::kRowMajor ? columns_ : rows_;
+  }
+
+  size_t StorageSize() const { return Lines() * leading_dimension_; }
+
+  bool IsCompact() const { return leading_dimension_ == LineSize(); }
+
+  bool SameShape(const DynMatrix& other) const {
+    return layout_ == other.layout_ &&
+           leading_dimension_ == other.leading_dimension_;
+  }
+
+  // Calls kernel(line, size) over the elements in storage order: once for a
+  // compact matrix, otherwise once per row or column.
+  template <class Kernel>
+  void ForEachLine(Kernel kernel) {
+    if (IsCompact()) {
+      kernel(data_, StorageSize());
+      return;
+    }
+    for (size_t line = 0; line < Lines(); ++line) {
+      kernel(data_ + line * leading_dimension_, LineSize());
+    }
+  }
+
+  // Calls kernel(other_line, this_line, size) over matching lines, converting
+  // other to this layout first when the layouts differ.
+  template <class Kernel>
+  void Combine(const DynMatrix& other, Kernel kernel) {
+    if (rows_ != other.rows_ || columns_ != other.columns_) {
+      throw MatrixSizeMismatch();
+    }
+    if (layout_ != other.layout_) {
+      Combine(other.WithLayout(layout_), kernel);
+      return;
+    }
+    if (SameShape(other) && IsCompact()) {
+      kernel(other.data_, data_, StorageSize());
+      return;
+    }
+    for (size_t line = 0; line < Lines(); ++line) {
+      kernel(other.data_ + line * other.leading_dimension_,
+             data_ + line * leading_dimension_, LineSize());
+    }
+  }
+
+  DynMatrix WithLayout(MatrixLayout layout) const {
+    DynMatrix result(rows_, columns_, layout);
+    for (size_t i = 0; i < rows_; ++i) {
+      for (size_t j = 0; j < columns_; ++j) {
+        result(i, j) = (*this)(i, j);
+      }
+    }
+    return result;
+  }
+
+  // c = a * b with all three stored in layout, where for column-major the
+  // storage holds the transposes and the roles of a and b are already swapped.
+  static void Multiply(const DynMatrix& a, const DynMatrix& b, DynMatrix& c,
+                       MatrixLayout layout) {
+    if (a.layout_ != layout) {
+      Multiply(a.WithLayout(layout), b, c, layout);
+      return;
+    }
+    if (b.layout_ != layout) {
+      Multiply(a, b.WithLayout(layout), c, layout);
+      return;
+    }
+    bool row_major = layout == MatrixLayout::kRowMajor;
+    size_t n = row_major ? a.rows_ : a.columns_;
+    size_t m = row_major ? a.columns_ : a.rows_;
+    size_t k = row_major ? b.columns_ : b.rows_;
+    if constexpr (matrix_kernels::kIsKernelType<ValueType>) {
+      using Tile = matrix_kernels::GemmTile<ValueType>;
+      if (n >= Tile::rows && k >= Tile::columns / 2 &&
+          n * m * k >= matrix_kernels::kGemmMinVolume) {
+        matrix_kernels::Gemm(n, m, k, a.data_, a.leading_dimension_, b.data_,
+                             b.leading_dimension_, c.data_,
+                             c.leading_dimension_);
+        return;
+      }
+    }
+    matrix_kernels::GemmSimple(n, m, k, a.data_, a.leading_dimension_,
+                               b.data_, b.leading_dimension_, c.data_,
+                               c.leading_dimension_);
+  }
+
+  void Allocate() {
+    size_t size = StorageSize();
+    if (size == 0) {
+      return;
+    }
+    void* memory = ::operator new(size * sizeof(ValueType),
+                                  std::align_val_t{alignment});
+    try {
+      std::uninitialized_value_construct_n(static_cast<ValueType*>(memory),
+                                           size);
+    } catch (...) {
+      ::operator delete(memory, std::align_val_t{alignment});
+      throw;
+    }
+    data_ = static_cast<ValueType*>(memory);
+  }
+
+  void Deallocate() {
+    if (data_ != nullptr) {
+      std::destroy_n(data_, StorageSize());
+      ::operator delete(data_, std::align_val_t{alignment});
+      data_ = nullptr;
+    }
+  }
+
+  void Swap(DynMatrix& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(rows_, other.rows_);
+    std::swap(columns_, other.columns_);
+    std::swap(leading_dimension_, other.leading_dimension_);
+    std::swap(layout_, other.layout_);
+  }
+
+  ValueType* data_ = nullptr;
+  size_t rows_ = 0;
+  size_t columns_ = 0;
+  size_t leading_dimension_ = 0;
+  MatrixLayout layout_ = MatrixLayout::kRowMajor;
+};
+
+template <class ValueType>
+DynMatrix<ValueType> operator*(const ValueType& value,
+                               const DynMatrix<ValueType>& matrix) {
+  return matrix * value;
+}
+
+template <class ValueType>
+DynMatrix<ValueType> GetTransposed(const DynMatrix<ValueType>& matrix) {
+  DynMatrix<ValueType> result(matrix.ColumnsNumber(), matrix.RowsNumber(),
+                              matrix.Layout());
+  for (size_t i = 0; i < matrix.RowsNumber(); ++i) {
+    for (size_t j = 0; j < matrix.ColumnsNumber(); ++j) {
+      result(j, i) = matrix(i, j);
+    }
+  }
+  return result;
+}
+
+template <class ValueType>
+std::ostream& operator<<(std::ostream& ostream,
+                         const DynMatrix<ValueType>& matrix) {
+  for (size_t i = 0; i < matrix.RowsNumber(); ++i) {
+    for (size_t j = 0; j < matrix.ColumnsNumber(); ++j) {
+      ostream << matrix(i, j);
+      if (j + 1 != matrix.ColumnsNumber()) {
+        ostream << ' ';
+      }
+    }
+    ostream << '\n';
+  }
+  return ostream;
+}
+
+// Reads RowsNumber() x ColumnsNumber() elements row by row into a matrix
+// sized beforehand, e.g. from dimensions read from the same stream.
+template <class ValueType>
+std::istream& operator>>(std::istream& istream,
+                         DynMatrix<ValueType>& matrix) {
+  for (size_t i = 0; i < matrix.RowsNumber(); ++i) {
+    for (size_t j = 0; j < matrix.ColumnsNumber(); ++j) {
+      istream >> matrix(i, j);
+    }
+  }
+  return istream;
+}
+
+#endif
@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <vector>
 
+#include "matrix_kernels.h"
+
 struct MatrixOutOfRange {};
 
 template <class ValueType, size_t N, size_t M>
@@ -39,66 +41,60 @@ struct Matrix {
   Matrix<ValueType, N, M> operator+(
       const Matrix<ValueType, N, M>& other) const {
     Matrix<ValueType, N, M> result;
-    for (size_t i = 0; i < N; ++i) {
-      for (size_t j = 0; j < M; ++j) {
-        result.matrix_[i][j] = matrix_[i][j] + other.matrix_[i][j];
-      }
-    }
+    matrix_kernels::Add(&matrix_[0][0], &other.matrix_[0][0],
+                        &result.matrix_[0][0], N * M);
     return result;
   }
 
   Matrix<ValueType, N, M> operator-(
       const Matrix<ValueType, N, M>& other) const {
     Matrix<ValueType, N, M> result;
-    for (size_t i = 0; i < N; ++i) {
-      for (size_t j = 0; j < M; ++j) {
-        result.matrix_[i][j] = matrix_[i][j] - other.matrix_[i][j];
-      }
-    }
+    matrix_kernels::Subtract(&matrix_[0][0], &other.matrix_[0][0],
+                             &result.matrix_[0][0], N * M);
     return result;
   }
 
+  // Arithmetic matrices of at least one register tile and kGemmMinVolume
+  // multiply-adds use the blocked kernel, chosen at compile time from N, M, K.
   template <size_t K>
   Matrix<ValueType, N, K> operator*(
       const Matrix<ValueType, M, K>& other) const {
-    Matrix<ValueType, N, K> result;
-    for (size_t i = 0; i < N; ++i) {
-      for (size_t j = 0; j < M; ++j) {
-        for (size_t k = 0; k < K; ++k) {
-          result.matrix_[i][k] += matrix_[i][j] * other.matrix_[j][k];
-        }
-      }
+    using Tile = matrix_kernels::GemmTile<ValueType>;
+    Matrix<ValueType, N, K> result{};
+    if constexpr (matrix_kernels::kIsKernelType<ValueType> &&
+                  N >= Tile::rows && K >= Tile::columns / 2 &&
+                  N * M * K >= matrix_kernels::kGemmMinVolume) {
+      matrix_kernels::Gemm(N, M, K, &matrix_[0][0], M, &other.matrix_[0][0], K,
+                           &result.matrix_[0][0], K);
+    } else {
+      matrix_kernels::GemmSimple(N, M, K, &matrix_[0][0], M,
+                                 &other.matrix_[0][0], K,
+                                 &result.matrix_[0][0], K);
     }
     return result;
   }
 
   Matrix<ValueType, N, M> operator*(ValueType value) const {
     Matrix<ValueType, N, M> result;
-    for (size_t i = 0; i < N; ++i) {
-      for (size_t j = 0; j < M; ++j) {
-        result.matrix_[i][j] = matrix_[i][j] * value;
-      }
-    }
+    matrix_kernels::Scale(&matrix_[0][0], value, &result.matrix_[0][0], N * M);
     return result;
   }
 
   Matrix operator/(ValueType value) const {
     Matrix<ValueType, N, M> result;
-    for (size_t i = 0; i < N; ++i) {
-      for (size_t j = 0; j < M; ++j) {
-        result.matrix_[i][j] = matrix_[i][j] / value;
-      }
-    }
+    matrix_kernels::Divide(&matrix_[0][0], value, &result.matrix_[0][0], N * M);
     return result;
   }
 
   Matrix<ValueType, N, M>& operator+=(const Matrix<ValueType, N, M>& other) {
-    *this = *this + other;
+    matrix_kernels::Add(&matrix_[0][0], &other.matrix_[0][0], &matrix_[0][0],
+                        N * M);
     return *this;
   }
 
   Matrix<ValueType, N, M>& operator-=(const Matrix<ValueType, N, M>& other) {
-    *this = *this - other;
+    matrix_kernels::Subtract(&matrix_[0][0], &other.matrix_[0][0],
+                             &matrix_[0][0], N * M);
     return *this;
   }
 
@@ -109,24 +105,17 @@ struct Matrix {
   }
 
   Matrix<ValueType, N, M>& operator*=(const ValueType& value) {
-    *this = *this * value;
+    matrix_kernels::Scale(&matrix_[0][0], value, &matrix_[0][0], N * M);
     return *this;
   }
 
   Matrix<ValueType, N, M>& operator/=(const ValueType& value) {
-    *this = *this / value;
+    matrix_kernels::Divide(&matrix_[0][0], value, &matrix_[0][0], N * M);
     return *this;
   }
 
   bool operator==(const Matrix<ValueType, N, M>& other) const {
-    for (size_t i = 0; i < N; ++i) {
-      for (size_t j = 0; j < M; ++j) {
-        if (matrix_[i][j] != other.matrix_[i][j]) {
-          return false;
-        }
-      }
-    }
-    return true;
+    return matrix_kernels::Equal(&matrix_[0][0], &other.matrix_[0][0], N * M);
   }
 
   bool operator!=(const Matrix<ValueType, N, M>& other) const {
@@ -149,11 +138,7 @@ template <class ValueType, size_t N, size_t M>
 Matrix<ValueType, N, M> operator*(const Matrix<ValueType, N, M>& matrix,
                                   const ValueType& value) {
   Matrix<ValueType, N, M> result;
-  for (size_t i = 0; i < N; ++i) {
-    for (size_t j = 0; j < M; ++j) {
-      result(i, j) = matrix(i, j) * value;
-    }
-  }
+  matrix_kernels::Scale(&matrix(0, 0), value, &result(0, 0), N * M);
   return result;
 }
 
@@ -167,14 +152,19 @@ template <class ValueType, size_t N, size_t M>
 Matrix<ValueType, N, M> operator/(const Matrix<ValueType, N, M>& matrix,
                                   const ValueType& value) {
   Matrix<ValueType, N, M> result;
-  for (size_t i = 0; i < N; ++i) {
-    for (size_t j = 0; j < M; ++j) {
-      result(i, j) = matrix(i, j) / value;
-    }
-  }
+  matrix_kernels::Divide(&matrix(0, 0), value, &result(0, 0), N * M);
   return result;
 }
 
+// matrix += alpha * other in a single pass over both.
+template <class ValueType, size_t N, size_t M>
+Matrix<ValueType, N, M>& Axpy(Matrix<ValueType, N, M>& matrix,
+                              const ValueType& alpha,
+                              const Matrix<ValueType, N, M>& other) {
+  matrix_kernels::Axpy(alpha, &other(0, 0), &matrix(0, 0), N * M);
+  return matrix;
+}
+
 template <class ValueType, size_t N, size_t M>
 std::ostream& operator<<(std::ostream& ostream,
                          Matrix<ValueType, N, M> matrix) {
@@ -0,0 +1,312 @@
+#ifndef MATRIX_KERNELS_H
+#define MATRIX_KERNELS_H
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATRIX_KERNELS_X86
+#endif
+
+// Kernels over contiguous row-major storage shared by the matrix types. Leading dimensions are given in
+// elements, so the same code serves compact and padded rows.
+namespace matrix_kernels {
+
+// Value types that take the blocked and vectorized paths; everything else uses the plain loops.
+template <class T>
+inline constexpr bool kIsKernelType = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+// Element types of the vectorized element-wise kernels.
+template <class T>
+inline constexpr bool kIsSimdType = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                                    std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>;
+
+// Register tile of the GEMM micro-kernel: rows x columns accumulators, where columns fill two 256-bit
+// vectors, so the tile takes 12 of the 16 AVX2 registers.
+template <class T>
+struct GemmTile {
+  static constexpr size_t rows = 6;
+  static constexpr size_t columns = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+};
+
+// Depth of the packed panels (they stay in L1 for one tile) and rows of A packed per block (L2).
+inline constexpr size_t kGemmDepthBlock = 256;
+inline constexpr size_t kGemmRowBlock = 72;
+// Smaller products are cheaper with the plain loop than with packing.
+inline constexpr size_t kGemmMinVolume = 16 * 16 * 16;
+
+// c[rows x columns] += a_panel * b_panel over depth steps; the panels are padded to a full tile.
+template <class T>
+inline __attribute__((always_inline)) void GemmMicroKernelBody(size_t depth, const T* a, const T* b, T* c,
+                                                               size_t ldc, size_t rows, size_t columns) {
+  constexpr size_t kRows = GemmTile<T>::rows;
+  constexpr size_t kColumns = GemmTile<T>::columns;
+  T accumulator[kRows][kColumns] = {};
+  for (size_t p = 0; p < depth; ++p) {
+    for (size_t r = 0; r < kRows; ++r) {
+      T value = a[p * kRows + r];
+      for (size_t s = 0; s < kColumns; ++s) {
+        accumulator[r][s] += value * b[p * kColumns + s];
+      }
+    }
+  }
+  if (rows == kRows && columns == kColumns) {
+    for (size_t r = 0; r < kRows; ++r) {
+      for (size_t s = 0; s < kColumns; ++s) {
+        c[r * ldc + s] += accumulator[r][s];
+      }
+    }
+  } else {
+    for (size_t r = 0; r < rows; ++r) {
+      for (size_t s = 0; s < columns; ++s) {
+        c[r * ldc + s] += accumulator[r][s];
+      }
+    }
+  }
+}
+
+template <class T>
+void GemmMicroKernel(size_t depth, const T* a, const T* b, T* c, size_t ldc, size_t rows, size_t columns) {
+  GemmMicroKernelBody(depth, a, b, c, ldc, rows, columns);
+}
+
+#ifdef MATRIX_KERNELS_X86
+// The same body compiled for AVX2 and FMA, where the tile loops vectorize to 256-bit registers.
+template <class T>
+__attribute__((target("avx2,fma"))) void GemmMicroKernelAvx2(size_t depth, const T* a, const T* b, T* c,
+                                                              size_t ldc, size_t rows, size_t columns) {
+  GemmMicroKernelBody(depth, a, b, c, ldc, rows, columns);
+}
+
+// AVX2 together with FMA, which every AVX2 processor in practice also has.
+inline bool HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return has_avx2;
+}
+#endif
+
+// c[n x k] += a[n x m] * b[m x k]. Blocks of B are packed into column panels and blocks of A into row
+// panels, both zero-padded to whole tiles, so the micro-kernel streams contiguous memory and never
+// branches on edges until the final store.
+template <class T>
+void Gemm(size_t n, size_t m, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+  constexpr size_t kRows = GemmTile<T>::rows;
+  constexpr size_t kColumns = GemmTile<T>::columns;
+  constexpr size_t kRowBlock = (kGemmRowBlock + kRows - 1) / kRows * kRows;
+  auto micro_kernel = &GemmMicroKernel<T>;
+#ifdef MATRIX_KERNELS_X86
+  if (HasAvx2()) {
+    micro_kernel = &GemmMicroKernelAvx2<T>;
+  }
+#endif
+
+  thread_local std::vector<T> a_panels;
+  thread_local std::vector<T> b_panels;
+  a_panels.resize(kGemmDepthBlock * kRowBlock);
+  b_panels.resize(kGemmDepthBlock * ((k + kColumns - 1) / kColumns * kColumns));
+  for (size_t pp = 0; pp < m; pp += kGemmDepthBlock) {
+    size_t depth = std::min(kGemmDepthBlock, m - pp);
+    for (size_t j = 0; j < k; j += kColumns) {
+      T* panel = b_panels.data() + j * depth;
+      for (size_t p = 0; p < depth; ++p) {
+        for (size_t s = 0; s < kColumns; ++s) {
+          panel[p * kColumns + s] = j + s < k ? b[(pp + p) * ldb + j + s] : T{};
+        }
+      }
+    }
+
+    for (size_t ii = 0; ii < n; ii += kRowBlock) {
+      size_t block_rows = std::min(kRowBlock, n - ii);
+      for (size_t i = 0; i < block_rows; i += kRows) {
+        T* panel = a_panels.data() + i * depth;
+        for (size_t p = 0; p < depth; ++p) {
+          for (size_t r = 0; r < kRows; ++r) {
+            panel[p * kRows + r] = i + r < block_rows ? a[(ii + i + r) * lda + pp + p] : T{};
+          }
+        }
+      }
+      for (size_t j = 0; j < k; j += kColumns) {
+        for (size_t i = 0; i < block_rows; i += kRows) {
+          micro_kernel(depth, a_panels.data() + i * depth, b_panels.data() + j * depth, c + (ii + i) * ldc + j, ldc,
+                       std::min(kRows, block_rows - i), std::min(kColumns, k - j));
+        }
+      }
+    }
+  }
+}
+
+// c[n x k] += a[n x m] * b[m x k] by rows of B, for value types or sizes the blocked kernel does not take.
+template <class T>
+void GemmSimple(size_t n, size_t m, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < m; ++j) {
+      for (size_t s = 0; s < k; ++s) {
+        c[i * ldc + s] += a[i * lda + j] * b[j * ldb + s];
+      }
+    }
+  }
+}
+
+enum class ElementOperation { kAdd, kSubtract, kMultiply, kDivide, kAxpy };
+
+// One element, or one vector of elements, of out = a + b, a - b, a * value, a / value or a + b * value.
+// Results go through a reference so that no vector is returned by value across targets.
+template <ElementOperation Operation, class X, class T>
+inline __attribute__((always_inline)) void ApplyElementOperation(X& out, const X& a, const X& b, const T& value) {
+  if constexpr (Operation == ElementOperation::kAdd) {
+    out = a + b;
+  } else if constexpr (Operation == ElementOperation::kSubtract) {
+    out = a - b;
+  } else if constexpr (Operation == ElementOperation::kMultiply) {
+    out = a * value;
+  } else if constexpr (Operation == ElementOperation::kDivide) {
+    out = a / value;
+  } else {
+    out = a + b * value;
+  }
+}
+
+template <ElementOperation Operation, class T>
+void MapScalar(const T* a, const T* b, const T& value, T* out, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    ApplyElementOperation<Operation>(out[i], a[i], b[i], value);
+  }
+}
+
+template <class T>
+bool EqualScalar(const T* a, const T* b, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    if (a[i] != b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#ifdef MATRIX_KERNELS_X86
+// Bytes-wide vectors of T in GCC's vector extension, lowered to SSE2 registers at 16 bytes and to AVX2
+// registers at 32 bytes inside a function compiled for that target. Vectors are only ever passed
+// between always-inline helpers, so no AVX values cross a default-target call boundary.
+template <class T, size_t Bytes>
+struct SimdVector {
+  using Type __attribute__((vector_size(Bytes))) = T;
+};
+
+template <ElementOperation Operation, size_t Bytes, class T>
+inline __attribute__((always_inline)) void MapBody(const T* a, const T* b, const T& value, T* out, size_t size) {
+  using Vector = typename SimdVector<T, Bytes>::Type;
+  constexpr size_t kLanes = Bytes / sizeof(T);
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    Vector x;
+    Vector y;
+    std::memcpy(&x, a + i, Bytes);
+    std::memcpy(&y, b + i, Bytes);
+    Vector result;
+    ApplyElementOperation<Operation>(result, x, y, value);
+    std::memcpy(out + i, &result, Bytes);
+  }
+  MapScalar<Operation>(a + i, b + i, value, out + i, size - i);
+}
+
+template <size_t Bytes, class T>
+inline __attribute__((always_inline)) bool EqualBody(const T* a, const T* b, size_t size) {
+  using Vector = typename SimdVector<T, Bytes>::Type;
+  constexpr size_t kLanes = Bytes / sizeof(T);
+  size_t i = 0;
+  for (; i + kLanes <= size; i += kLanes) {
+    Vector x;
+    Vector y;
+    std::memcpy(&x, a + i, Bytes);
+    std::memcpy(&y, b + i, Bytes);
+    auto differs = x != y;
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      if (differs[lane] != 0) {
+        return false;
+      }
+    }
+  }
+  return EqualScalar(a + i, b + i, size - i);
+}
+
+template <ElementOperation Operation, class T>
+__attribute__((target("avx2"))) void MapAvx2(const T* a, const T* b, const T& value, T* out, size_t size) {
+  MapBody<Operation, 32>(a, b, value, out, size);
+}
+
+template <ElementOperation Operation, class T>
+void MapSse(const T* a, const T* b, const T& value, T* out, size_t size) {
+  MapBody<Operation, 16>(a, b, value, out, size);
+}
+
+template <class T>
+__attribute__((target("avx2"))) bool EqualAvx2(const T* a, const T* b, size_t size) {
+  return EqualBody<32>(a, b, size);
+}
+#endif
+
+// out[i] = a[i] (op) b[i] or a[i] (op) value for i < size; out may alias a or b. Float, double, int32 and
+// int64 elements use AVX2 when the processor has it and SSE2 otherwise on x86; other types, integer
+// division and other architectures take the scalar loop.
+template <ElementOperation Operation, class T>
+void Map(const T* a, const T* b, const T& value, T* out, size_t size) {
+#ifdef MATRIX_KERNELS_X86
+  // There is no vector integer division, and scalarized vector code is slower than the plain loop.
+  if constexpr (kIsSimdType<T> && !(Operation == ElementOperation::kDivide && std::is_integral_v<T>)) {
+    if (HasAvx2()) {
+      MapAvx2<Operation>(a, b, value, out, size);
+    } else {
+      MapSse<Operation>(a, b, value, out, size);
+    }
+    return;
+  }
+#endif
+  MapScalar<Operation>(a, b, value, out, size);
+}
+
+template <class T>
+void Add(const T* a, const T* b, T* out, size_t size) {
+  Map<ElementOperation::kAdd>(a, b, T{}, out, size);
+}
+
+template <class T>
+void Subtract(const T* a, const T* b, T* out, size_t size) {
+  Map<ElementOperation::kSubtract>(a, b, T{}, out, size);
+}
+
+template <class T>
+void Scale(const T* a, const T& value, T* out, size_t size) {
+  Map<ElementOperation::kMultiply>(a, a, value, out, size);
+}
+
+template <class T>
+void Divide(const T* a, const T& value, T* out, size_t size) {
+  Map<ElementOperation::kDivide>(a, a, value, out, size);
+}
+
+// y[i] += alpha * x[i] in a single pass.
+template <class T>
+void Axpy(const T& alpha, const T* x, T* y, size_t size) {
+  Map<ElementOperation::kAxpy>(y, x, alpha, y, size);
+}
+
+// Element-wise a[i] == b[i] for all i < size, with IEEE semantics for floating point.
+template <class T>
+bool Equal(const T* a, const T* b, size_t size) {
+#ifdef MATRIX_KERNELS_X86
+  if constexpr (kIsSimdType<T>) {
+    return HasAvx2() ? EqualAvx2(a, b, size) : EqualBody<16>(a, b, size);
+  }
+#endif
+  return EqualScalar(a, b, size);
+}
+
+}  // namespace matrix_kernels
+
+#endif
@@ -3,12 +3,15 @@
 
 #include <array>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <type_traits>
 
 #include "rational.h"
 
 #include "matrix.h"
 #include "matrix.h"  // check include guards
+#include "dyn_matrix.h"
 
 template <class T, size_t N, size_t M>
 void EqualMatrix(const Matrix<T, N, M>& matrix, const std::array<std::array<T, M>, N>& arr) {
@@ -150,6 +153,50 @@ TEST_CASE("MatrixMultiplication", "[MatrixOperators]") {
                  std::is_same_v<ReturnType, Matrix<Rational, 3, 1>>));
 }
 
+TEST_CASE("BlockedMultiplication", "[MatrixOperators]") {
+  // Sizes straddle the register tiles and the packed block depth, so every edge path is taken.
+  static Matrix<int64_t, 75, 260> a;
+  static Matrix<int64_t, 260, 37> b;
+  static Matrix<double, 75, 260> a_real;
+  static Matrix<double, 260, 37> b_real;
+  for (size_t i = 0; i < 75; ++i) {
+    for (size_t j = 0; j < 260; ++j) {
+      a(i, j) = static_cast<int64_t>((i * 7 + j * 3) % 11) - 5;
+      a_real(i, j) = static_cast<double>(a(i, j)) / 4;
+    }
+  }
+  for (size_t i = 0; i < 260; ++i) {
+    for (size_t j = 0; j < 37; ++j) {
+      b(i, j) = static_cast<int64_t>((i * 5 + j) % 13) - 6;
+      b_real(i, j) = static_cast<double>(b(i, j)) / 8;
+    }
+  }
+
+  const auto product = a * b;
+  const auto product_real = a_real * b_real;
+  for (size_t i = 0; i < 75; ++i) {
+    for (size_t k = 0; k < 37; ++k) {
+      int64_t expected = 0;
+      for (size_t j = 0; j < 260; ++j) {
+        expected += a(i, j) * b(j, k);
+      }
+      REQUIRE(product(i, k) == expected);
+      REQUIRE(product_real(i, k) == static_cast<double>(expected) / 32);
+    }
+  }
+
+  Matrix<float, 16, 16> identity{};
+  Matrix<float, 16, 16> values{};
+  for (size_t i = 0; i < 16; ++i) {
+    identity(i, i) = 1;
+    for (size_t j = 0; j < 16; ++j) {
+      values(i, j) = static_cast<float>(i) - static_cast<float>(j) / 2;
+    }
+  }
+  REQUIRE(identity * values == values);
+  REQUIRE(values * identity == values);
+}
+
 TEST_CASE("ScalarMultiplication", "[MatrixOperators]") {
   Matrix<Rational, 3, 2> matrix{Rational{1, 2}, Rational{-1, 2}, Rational{1}};
   const int delta = -2;
@@ -164,6 +211,71 @@ TEST_CASE("ScalarMultiplication", "[MatrixOperators]") {
                  std::is_same_v<ReturnType, Matrix<Rational, 3, 2>>));
 }
 
+template <class T>
+void CheckElementWise() {
+  // 7 x 5 elements leave a scalar tail after every vector width.
+  Matrix<T, 7, 5> a{};
+  Matrix<T, 7, 5> b{};
+  for (size_t i = 0; i < 7; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      a(i, j) = static_cast<T>(static_cast<int>(i * 5 + j) - 12);
+      b(i, j) = static_cast<T>(static_cast<int>(i * 3 + j * 2) % 9 + 1);
+    }
+  }
+  const T two = 2;
+  const auto sum = a + b;
+  const auto difference = a - b;
+  const auto scaled = a * two;
+  const auto left_scaled = two * a;
+  const auto divided = a / two;
+  auto fused = a;
+  Axpy(fused, two, b);
+  for (size_t i = 0; i < 7; ++i) {
+    for (size_t j = 0; j < 5; ++j) {
+      REQUIRE(sum(i, j) == a(i, j) + b(i, j));
+      REQUIRE(difference(i, j) == a(i, j) - b(i, j));
+      REQUIRE(scaled(i, j) == a(i, j) * two);
+      REQUIRE(left_scaled(i, j) == a(i, j) * two);
+      REQUIRE(divided(i, j) == a(i, j) / two);
+      REQUIRE(fused(i, j) == a(i, j) + two * b(i, j));
+    }
+  }
+
+  auto in_place = a;
+  in_place += b;
+  REQUIRE(in_place == sum);
+  in_place -= b;
+  REQUIRE(in_place == a);
+  in_place *= two;
+  REQUIRE(in_place == scaled);
+  in_place /= two;
+  REQUIRE(in_place == a);
+  in_place(6, 4) += 1;
+  REQUIRE(in_place != a);
+  in_place(6, 4) -= 1;
+  in_place(0, 1) += 1;
+  REQUIRE(in_place != a);
+}
+
+TEST_CASE("ElementWise", "[MatrixOperators]") {
+  CheckElementWise<float>();
+  CheckElementWise<double>();
+  CheckElementWise<int32_t>();
+  CheckElementWise<int64_t>();
+  CheckElementWise<int16_t>();
+
+  Matrix<double, 3, 3> zeros{};
+  Matrix<double, 3, 3> negative_zeros{};
+  negative_zeros(2, 2) = -0.0;
+  REQUIRE(zeros == negative_zeros);
+  negative_zeros(1, 0) = std::numeric_limits<double>::quiet_NaN();
+  REQUIRE(negative_zeros != negative_zeros);
+
+  Matrix<Rational, 1, 2> rational{Rational{1, 2}, Rational{1, 3}};
+  Axpy(rational, Rational{3}, Matrix<Rational, 1, 2>{Rational{1}, Rational{-1, 3}});
+  EqualMatrix(rational, std::array<std::array<Rational, 2>, 1>{Rational{7, 2}, Rational{-2, 3}});
+}
+
 TEST_CASE("ScalarDivision", "[MatrixOperators]") {
   Matrix<Rational, 3, 2> matrix{Rational{-1, 1}, Rational{1, 2}, Rational{3, 4},
                                 Rational{-1, 4}, Rational{0, 1}, Rational{2, 1}};
@@ -417,4 +529,120 @@ TEST_CASE("GetInversed", "[MatrixMethods]") {
     static_assert((std::is_same_v<ReturnType, Matrix<Rational, 3, 3>>));
   }
 }
-#endif  // MATRIX_SQUARE_MATRIX_IMPLEMENTED
\ No newline at end of file
+#endif  // MATRIX_SQUARE_MATRIX_IMPLEMENTED
+
+TEST_CASE("DynMatrixStorage", "[DynMatrix]") {
+  DynMatrix<double> empty;
+  REQUIRE(empty.RowsNumber() == 0);
+  REQUIRE(empty.ColumnsNumber() == 0);
+
+  DynMatrix<double> row_major(5, 3);
+  DynMatrix<double> column_major(5, 3, MatrixLayout::kColumnMajor);
+  DynMatrix<double> padded(5, 3, MatrixLayout::kRowMajor, 8);
+  for (const auto* matrix : {&row_major, &column_major, &padded}) {
+    REQUIRE(reinterpret_cast<uintptr_t>(matrix->Data()) % 64 == 0);
+    REQUIRE(matrix->RowsNumber() == 5);
+    REQUIRE(matrix->ColumnsNumber() == 3);
+    REQUIRE(matrix->At(4, 2) == 0);
+  }
+  REQUIRE(row_major.LeadingDimension() == 3);
+  REQUIRE(column_major.LeadingDimension() == 5);
+  REQUIRE(padded.LeadingDimension() == 8);
+  REQUIRE_THROWS_AS(DynMatrix<double>(5, 3, MatrixLayout::kRowMajor, 2), MatrixSizeMismatch);  // NOLINT
+  REQUIRE_THROWS_AS(row_major.At(5, 0), MatrixOutOfRange);  // NOLINT
+
+  column_major(1, 2) = 7;
+  REQUIRE(column_major.Data()[2 * 5 + 1] == 7);
+  padded(1, 2) = 7;
+  REQUIRE(padded.Data()[1 * 8 + 2] == 7);
+
+  const Matrix<int, 2, 3> fixed{1, 2, 3, 4, 5, 6};
+  DynMatrix<int> dynamic(fixed, MatrixLayout::kColumnMajor);
+  REQUIRE(dynamic(1, 0) == 4);
+  REQUIRE(static_cast<Matrix<int, 2, 3>>(dynamic) == fixed);
+  REQUIRE_THROWS_AS((static_cast<Matrix<int, 3, 2>>(dynamic)), MatrixSizeMismatch);  // NOLINT
+
+  DynMatrix<int> copy = dynamic;
+  copy(0, 0) = 10;
+  REQUIRE(dynamic(0, 0) == 1);
+  DynMatrix<int> moved = std::move(copy);
+  REQUIRE(moved(0, 0) == 10);
+  copy = moved;
+  REQUIRE(copy == moved);
+
+  std::stringstream ss("2 3\n-1 0 4\n7 8 9");
+  size_t rows = 0;
+  size_t columns = 0;
+  ss >> rows >> columns;
+  DynMatrix<int> read(rows, columns);
+  ss >> read;
+  std::stringstream out;
+  out << read;
+  REQUIRE(out.str() == "-1 0 4\n7 8 9\n");
+  REQUIRE(GetTransposed(read)(2, 1) == 9);
+}
+
+TEST_CASE("DynMatrixOperators", "[DynMatrix]") {
+  const size_t n = 70;
+  const size_t m = 45;
+  const size_t k = 33;
+  DynMatrix<double> a(n, m);
+  DynMatrix<double> a_columns(n, m, MatrixLayout::kColumnMajor);
+  DynMatrix<double> a_padded(n, m, MatrixLayout::kRowMajor, 48);
+  DynMatrix<double> b(m, k, MatrixLayout::kColumnMajor, 50);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < m; ++j) {
+      a(i, j) = a_columns(i, j) = a_padded(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5;
+    }
+  }
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t j = 0; j < k; ++j) {
+      b(i, j) = static_cast<double>((i * 5 + j) % 13) / 4;
+    }
+  }
+  REQUIRE(a == a_columns);
+  REQUIRE(a == a_padded);
+
+  for (const auto* left : {&a, &a_columns, &a_padded}) {
+    const DynMatrix<double> product = *left * b;
+    REQUIRE(product.Layout() == left->Layout());
+    REQUIRE(product.RowsNumber() == n);
+    REQUIRE(product.ColumnsNumber() == k);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t s = 0; s < k; ++s) {
+        double expected = 0;
+        for (size_t j = 0; j < m; ++j) {
+          expected += a(i, j) * b(j, s);
+        }
+        REQUIRE(product(i, s) == expected);
+      }
+    }
+  }
+  REQUIRE_THROWS_AS(a * a, MatrixSizeMismatch);  // NOLINT
+
+  const auto sum = a + a_columns;
+  const auto difference = a_padded - a;
+  REQUIRE(sum == a * 2.0);
+  REQUIRE(sum == 2.0 * a_columns);
+  REQUIRE(sum / 2.0 == a_padded);
+  REQUIRE(difference == DynMatrix<double>(n, m));
+  auto fused = a_padded;
+  Axpy(fused, -3.0, a_columns);
+  REQUIRE(fused == a * -2.0);
+  REQUIRE_THROWS_AS(fused += b, MatrixSizeMismatch);  // NOLINT
+  const auto double_and_add = [](auto& matrix, const auto& other) -> auto& { return Axpy(matrix, 2.0, other); };
+  Matrix<double, 1, 2> fixed{1.0, 2.0};
+  DynMatrix<double> dynamic(fixed);
+  REQUIRE(static_cast<Matrix<double, 1, 2>>(double_and_add(dynamic, dynamic)) == double_and_add(fixed, fixed));
+
+  DynMatrix<Rational> rational(1, 2);
+  rational(0, 0) = Rational{1, 2};
+  rational(0, 1) = Rational{1, 3};
+  Axpy(rational, Rational{3}, rational);
+  REQUIRE(rational(0, 0) == Rational{2});
+  REQUIRE(rational(0, 1) == Rational{4, 3});
+  DynMatrix<Rational> rational_column(2, 1, MatrixLayout::kColumnMajor);
+  rational_column(0, 0) = Rational{3};
+  rational_column(1, 0) = Rational{-3, 4};
+  REQUIRE((rational * rational_column)(0, 0) == Rational{5});
+}